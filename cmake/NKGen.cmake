@@ -4,8 +4,17 @@ cmake_minimum_required(VERSION 3.10)
 
 function(generate_modules target)
 
-    # Get the list of modules passed to the function
-    set(modules ${ARGN})
+    # Get the list of modules passed to the function, UNITY compiles every generated source as one translation unit
+    cmake_parse_arguments(PARSE_ARGV 1 NKGEN_MODULES "UNITY" "" "")
+    set(modules ${NKGEN_MODULES_UNPARSED_ARGUMENTS})
+
+    set(unity_headers "")
+    set(unity_sources "")
+    set(unity_user_sources "")
+    set(unity_definitions "")
+    set(unity_private_definitions "")
+    set(unity_uses "")
+    set(unity_stamps "")
     
     # Create a directory for generated files
     set(GEN_DIR "${CMAKE_BINARY_DIR}/generated")
@@ -36,30 +45,221 @@ function(generate_modules target)
         # Generated file paths (we expect nkgen to produce these names)
         set(gen_header "${GEN_DIR}/${mod_base}.xml.h")
         set(gen_src    "${GEN_DIR}/${mod_base}.xml.c")
+        set(gen_dep    "${GEN_DIR}/${mod_base}.xml.d")
+        set(gen_stamp  "${GEN_DIR}/${mod_base}.xml.stamp")
+
+        # Files pulled in through <Include> are reported in a depfile where the generator supports it
+        # Per module statistics for the whole build, enabled with -DNKGEN_STATS_JSON=<path>
+        set(stats_args "")
+        if(NKGEN_STATS_JSON)
+            set(stats_args --stats-json ${NKGEN_STATS_JSON})
+        endif()
+
+        # Constructor backend, NKGEN_BACKEND_<module> overrides NKGEN_BACKEND for one module
+        set(backend_args "")
+        if(DEFINED NKGEN_BACKEND_${mod_base})
+            set(backend_args --backend ${NKGEN_BACKEND_${mod_base}})
+        elseif(NKGEN_BACKEND)
+            set(backend_args --backend ${NKGEN_BACKEND})
+        endif()
+
+        # View hierarchy stored at generation time, enabled with -DNKGEN_STATIC_LINKS=ON
+        set(emit_args "")
+        if(NKGEN_STATIC_LINKS)
+            set(emit_args --static-links)
+        endif()
+
+        # Arrange constant sized subtrees at generation time, enabled with -DNKGEN_PRECOMPUTE_LAYOUT=ON
+        if(NKGEN_PRECOMPUTE_LAYOUT)
+            list(APPEND emit_args --precompute-layout)
+        endif()
+
+        # Repeated strings and hex colours shared through one pool per module, enabled with -DNKGEN_POOL_CONSTANTS=ON
+        if(NKGEN_POOL_CONSTANTS)
+            list(APPEND emit_args --pool-constants)
+        endif()
+
+        # Identical subtrees share one init helper unless -DNKGEN_INLINE_SUBTREES=ON
+        if(NKGEN_INLINE_SUBTREES)
+            list(APPEND emit_args --inline-subtrees)
+        endif()
+
+        # _Create spread over N sources compiled in parallel, NKGEN_SPLIT_<module> overrides NKGEN_SPLIT for one module
+        # the chunk names only depend on N, nkgen also lists them in ${mod_base}.xml.sources for other build systems
+        set(split_count 1)
+        if(DEFINED NKGEN_SPLIT_${mod_base})
+            set(split_count ${NKGEN_SPLIT_${mod_base}})
+        elseif(NKGEN_SPLIT)
+            set(split_count ${NKGEN_SPLIT})
+        endif()
+
+        set(gen_chunks "")
+        if(split_count GREATER 1)
+            list(APPEND emit_args --split ${split_count})
+            math(EXPR last_chunk "${split_count} - 1")
+            foreach(chunk RANGE 1 ${last_chunk})
+                list(APPEND gen_chunks "${GEN_DIR}/${mod_base}.xml.${chunk}.c")
+            endforeach()
+            list(APPEND gen_chunks "${GEN_DIR}/${mod_base}.xml.sources")
+        endif()
+
+        # Dense view IDs and <module>_FindByName over a perfect hash of the names, enabled with -DNKGEN_VIEW_IDS=ON
+        if(NKGEN_VIEW_IDS)
+            list(APPEND emit_args --view-ids)
+        endif()
+
+        # Callbacks routed through a static table and <module>_Dispatch instead of per-view stores, implies the view IDs,
+        # enabled with -DNKGEN_ROUTE_EVENTS=ON, the host calls _Dispatch from its event loop
+        if(NKGEN_ROUTE_EVENTS)
+            list(APPEND emit_args --route-events)
+        endif()
+
+        # Containers first, then leaves, then deferred views, enabled with -DNKGEN_HOT_COLD_MEMBERS=ON
+        if(NKGEN_HOT_COLD_MEMBERS)
+            list(APPEND emit_args --hot-cold-members)
+        endif()
+
+        # Per module manifest of the struct members beside the generated sources, enabled with -DNKGEN_FOOTPRINT=ON,
+        # each build directory keeps its own since the order and the backend may differ between them,
+        # NKGEN_FOOTPRINT_LIMIT_<module> caps sizeof(<module>_t) in bytes through a _Static_assert
+        set(gen_footprint "")
+        if(NKGEN_FOOTPRINT)
+            set(gen_footprint "${GEN_DIR}/${mod_base}.xml.footprint")
+            list(APPEND emit_args --footprint ${gen_footprint})
+        endif()
+
+        # Module struct kept out of the header so layout edits only recompile the module source,
+        # NKGEN_OPAQUE_HEADER_<module> overrides NKGEN_OPAQUE_HEADERS for one module, UserControl modules embedded by value must stay off
+        set(opaque_header ${NKGEN_OPAQUE_HEADERS})
+        if(DEFINED NKGEN_OPAQUE_HEADER_${mod_base})
+            set(opaque_header ${NKGEN_OPAQUE_HEADER_${mod_base}})
+        endif()
+
+        if(opaque_header)
+            list(APPEND emit_args --opaque-header)
+        endif()
+
+        set(depfile_args "")
+        if(CMAKE_GENERATOR MATCHES "Ninja" OR NOT CMAKE_VERSION VERSION_LESS 3.20)
+            set(depfile_args DEPFILE ${gen_dep})
+        endif()
         
+        # nkgen leaves unchanged outputs untouched, so the stamp is the output and the generated files are byproducts,
+        # the module sources are only recompiled when the markup changed what they contain
         add_custom_command(
-            OUTPUT ${gen_header} ${gen_src}  # These files are the output of the custom command
-            COMMAND ${NKGEN} ${mod_base} ${xml_file} ${gen_header} ${gen_src}
+            OUTPUT ${gen_stamp}
+            BYPRODUCTS ${gen_header} ${gen_src} ${gen_chunks} ${gen_footprint}
+            COMMAND ${NKGEN} --depfile ${gen_dep} --stamp ${gen_stamp} ${stats_args} ${backend_args} ${emit_args} ${mod_base} ${xml_file} ${gen_header} ${gen_src}
             COMMENT "RUNNING NKGEN ${mod_base} ${xml_file} ${gen_header} ${gen_src}"
             DEPENDS ${xml_file} nkgen            # nkgen depends on the .xml file
+            ${depfile_args}
             WORKING_DIRECTORY "${CMAKE_BINARY_DIR}"
             VERBATIM
         )
 
+        if(NKGEN_MODULES_UNITY)
+            # built by the unity library below, the module name stays linkable
+            list(APPEND unity_headers ${gen_header})
+            list(APPEND unity_sources ${gen_src} ${gen_chunks})
+            list(APPEND unity_user_sources ${src_file})
+            list(APPEND unity_stamps ${gen_stamp})
+            list(APPEND unity_definitions "${mod_base_upper}_BUILD")
+
+            if(DEFINED NKGEN_FOOTPRINT_LIMIT_${mod_base})
+                list(APPEND unity_private_definitions "${mod_base_upper}_XML_FOOTPRINT_LIMIT=${NKGEN_FOOTPRINT_LIMIT_${mod_base}}")
+            endif()
+
+            if(DEFINED NKGEN_USES_${mod_base})
+                list(APPEND unity_uses ${NKGEN_USES_${mod_base}})
+            endif()
+
+            add_library(${mod_base} INTERFACE)
+            target_link_libraries(${mod_base} INTERFACE ${target}_modules)
+            continue()
+        endif()
+
         # add the module as a static library
         add_library(${mod_base} STATIC 
+            ${gen_stamp}
             ${gen_header} 
             ${gen_src}
+            ${gen_chunks}
             ${src_file}
         )
 
         target_link_libraries(${mod_base} PUBLIC NanoKit)
 
         target_compile_definitions(${mod_base} PUBLIC "${mod_base_upper}_BUILD")
+
+        if(DEFINED NKGEN_FOOTPRINT_LIMIT_${mod_base})
+            target_compile_definitions(${mod_base} PRIVATE "${mod_base_upper}_XML_FOOTPRINT_LIMIT=${NKGEN_FOOTPRINT_LIMIT_${mod_base}}")
+        endif()
         target_include_directories(${mod_base} PUBLIC ${GEN_DIR})
+
+        # UserControl modules a module references, NKGEN_USES_<module> builds their headers first and links them
+        if(DEFINED NKGEN_USES_${mod_base})
+            target_link_libraries(${mod_base} PUBLIC ${NKGEN_USES_${mod_base}})
+        endif()
+
         message("include directory: ${NANOKIT_DIR}")
         target_link_libraries(${target} PUBLIC ${mod_base})
         
     endforeach()
 
+    if(NKGEN_MODULES_UNITY AND modules)
+        set(unity_src "${GEN_DIR}/${target}.modules.c")
+
+        # the generated sources are only included, the unity source is what gets compiled
+        list(FILTER unity_sources EXCLUDE REGEX "\\.sources$")
+        set_source_files_properties(${unity_sources} PROPERTIES HEADER_FILE_ONLY ON)
+
+        add_custom_command(
+            OUTPUT ${unity_src}
+            COMMAND ${NKGEN} --unity ${unity_src} ${unity_sources}
+            COMMENT "RUNNING NKGEN --unity ${unity_src}"
+            DEPENDS nkgen
+            WORKING_DIRECTORY "${CMAKE_BINARY_DIR}"
+            VERBATIM
+        )
+
+        add_library(${target}_modules STATIC
+            ${unity_src}
+            ${unity_stamps}
+            ${unity_headers}
+            ${unity_sources}
+            ${unity_user_sources}
+        )
+
+        target_link_libraries(${target}_modules PUBLIC NanoKit)
+
+        target_compile_definitions(${target}_modules PUBLIC ${unity_definitions})
+
+        # the limits only guard the generated sources compiled here, like the PRIVATE ones of a module library
+        if(unity_private_definitions)
+            target_compile_definitions(${target}_modules PRIVATE ${unity_private_definitions})
+        endif()
+        target_include_directories(${target}_modules PUBLIC ${GEN_DIR})
+
+        # UserControl modules generated by another generate_modules call, the ones in this call are already built here
+        if(unity_uses)
+            list(REMOVE_DUPLICATES unity_uses)
+        endif()
+
+        foreach(used ${unity_uses})
+            set(used_here FALSE)
+            foreach(mod ${modules})
+                get_filename_component(used_base ${mod} NAME)
+                if(used_base STREQUAL used)
+                    set(used_here TRUE)
+                endif()
+            endforeach()
+
+            if(NOT used_here)
+                target_link_libraries(${target}_modules PUBLIC ${used})
+            endif()
+        endforeach()
+
+        target_link_libraries(${target} PUBLIC ${target}_modules)
+    endif()
+
 endfunction()
@@ -0,0 +1,539 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  bench.c
+** Module       :  nkgen_bench
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen phase benchmark over synthetic layouts
+**
+***************************************************************/
+
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include <nkgen/nkgen.h>
+
+#include "synth.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define DEFAULT_SIZE        (2000)
+#define DEFAULT_ITERATIONS  (20)
+#define DEFAULT_SEED        (0x6b6e6765)
+
+#define SCALING_STEPS       (4)     /* N, 2N, 4N and 8N */
+#define SCALING_RUNS        (5)     /* best of, keeps timer noise out of the ratios */
+#define SCALING_TIME_SLACK  (2.0)   /* time may grow this much faster than linear */
+#define SCALING_COUNT_SLACK (1.25)  /* allocation counts are deterministic, so the bound is tight */
+#define SCALING_BYTES_SLACK (2.0)   /* geometric buffer growth can overshoot by up to one doubling */
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    SynthShape shape;
+    size_t size;
+    size_t iterations;
+
+    size_t inputSize;
+    size_t nodeCount;
+    size_t propertyCount;
+    size_t outputSize;
+
+    double meanSeconds[NKGEN_PHASE_COUNT];
+    double minSeconds[NKGEN_PHASE_COUNT];
+} BenchResult;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static NkGenBackend backend = NKGEN_BACKEND_UNROLLED;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static int RunScaling(size_t size, uint32_t seed);
+static int RunShape(SynthShape shape, size_t size, size_t iterations, uint32_t seed, const char* directory, BenchResult* result);
+static void PrintResult(const BenchResult* result);
+static void WriteResultJson(FILE* file, const BenchResult* result);
+
+static const char* BackendName(NkGenBackend backend);
+
+static int LoadFile(const char* path, char** buffer, size_t* size);
+static int WriteFile(const char* path, const char* contents, size_t size);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+int main(int argc, char *argv[])
+{
+    const char* shapeName = "all";
+    size_t size = DEFAULT_SIZE;
+    size_t iterations = DEFAULT_ITERATIONS;
+    uint32_t seed = DEFAULT_SEED;
+    const char* directory = ".";
+    const char* jsonPath = NULL;
+    bool scaling = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--scaling") == 0)
+        {
+            scaling = true;
+        }
+        else if (strcmp(argv[i], "--shape") == 0 && i + 1 < argc)
+        {
+            shapeName = argv[++i];
+        }
+        else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc)
+        {
+            size = (size_t)strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+        {
+            iterations = (size_t)strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "--backend") == 0 && i + 1 < argc && nkgen_backend_from_name(argv[i + 1], &backend))
+        {
+            i++;
+        }
+        else if (strcmp(argv[i], "--dir") == 0 && i + 1 < argc)
+        {
+            directory = argv[++i];
+        }
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+        {
+            jsonPath = argv[++i];
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [--shape <name|all>] [--size <n>] [--iterations <n>] [--seed <n>] [--backend unrolled|table|prototype] [--dir <path>] [--json <results.jsonl>]\n", argv[0]);
+            fprintf(stderr, "       %s --scaling [--size <n>] [--seed <n>] [--backend unrolled|table|prototype]\n", argv[0]);
+            fprintf(stderr, "Shapes:");
+            for (size_t shape = 0; shape < SYNTH_SHAPE_COUNT; shape++) fprintf(stderr, " %s", SynthShapeName((SynthShape)shape));
+            fprintf(stderr, "\n");
+            return 1;
+        }
+    }
+
+    if (size == 0 || iterations == 0)
+    {
+        fprintf(stderr, "Error: size and iterations must be positive\n");
+        return 1;
+    }
+
+    if (scaling)
+    {
+        return RunScaling(size, seed);
+    }
+
+    SynthShape firstShape = 0;
+    SynthShape lastShape = SYNTH_SHAPE_COUNT - 1;
+
+    if (strcmp(shapeName, "all") != 0)
+    {
+        firstShape = lastShape = SynthShapeFromName(shapeName);
+
+        if (firstShape == SYNTH_SHAPE_COUNT)
+        {
+            fprintf(stderr, "Error: Unknown shape '%s'\n", shapeName);
+            return 1;
+        }
+    }
+
+    FILE* jsonFile = NULL;
+
+    if (jsonPath)
+    {
+        jsonFile = fopen(jsonPath, "w");
+
+        if (!jsonFile)
+        {
+            fprintf(stderr, "Error: Could not open '%s' for writing\n", jsonPath);
+            return 1;
+        }
+    }
+
+    printf("%-11s %-9s %-9s %10s %10s %10s %10s\n", "shape", "backend", "phase", "mean ms", "min ms", "MB/s", "knodes/s");
+
+    int status = 0;
+
+    for (SynthShape shape = firstShape; shape <= lastShape; shape++)
+    {
+        BenchResult result;
+
+        if (RunShape(shape, size, iterations, seed, directory, &result))
+        {
+            status = 1;
+            continue;
+        }
+
+        PrintResult(&result);
+
+        if (jsonFile)
+        {
+            WriteResultJson(jsonFile, &result);
+        }
+    }
+
+    if (jsonFile)
+    {
+        fclose(jsonFile);
+    }
+
+    return status;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static int RunScaling(size_t size, uint32_t seed)
+{
+    /* every shape at N, 2N, 4N and 8N, failing when time or allocations grow faster than linear */
+    int status = 0;
+
+    printf("%-11s %8s %10s %12s %14s %8s %8s %8s\n", "shape", "size", "best ms", "allocs", "alloc bytes", "time x", "count x", "bytes x");
+
+    for (size_t shape = 0; shape < SYNTH_SHAPE_COUNT; shape++)
+    {
+        double baseSeconds = 0.0;
+        size_t baseAllocationCount = 0;
+        size_t baseAllocationBytes = 0;
+
+        for (size_t step = 0; step < SCALING_STEPS; step++)
+        {
+            size_t stepSize = size << step;
+            size_t layoutSize = 0;
+            char* layout = SynthGenerateLayout((SynthShape)shape, stepSize, seed, &layoutSize);
+
+            NkGenOptions options = {
+                .moduleName = "Scaling",
+                .backend = backend
+            };
+
+            double bestSeconds = -1.0;
+            NkGenStats stats;
+
+            for (size_t run = 0; run < SCALING_RUNS; run++)
+            {
+                NkGenOutput output;
+                NkGenResult result = nkgen_generate(layout, layoutSize, &options, &output);
+
+                if (result != NKGEN_OK)
+                {
+                    fprintf(stderr, "Error: Could not generate %s layout: %s\n", SynthShapeName((SynthShape)shape), nkgen_result_string(result));
+                    nkgen_free_output(&output);
+                    free(layout);
+                    return 1;
+                }
+
+                stats = output.stats;
+
+                double seconds = 0.0;
+                for (size_t phase = NKGEN_PHASE_PARSE; phase <= NKGEN_PHASE_SOURCE; phase++)
+                {
+                    seconds += stats.phaseSeconds[phase];
+                }
+
+                if (bestSeconds < 0.0 || seconds < bestSeconds)
+                {
+                    bestSeconds = seconds;
+                }
+
+                nkgen_free_output(&output);
+            }
+
+            free(layout);
+
+            if (step == 0)
+            {
+                baseSeconds = bestSeconds;
+                baseAllocationCount = stats.allocationCount;
+                baseAllocationBytes = stats.allocationBytes;
+            }
+
+            double linear = (double)(1u << step);
+            double timeGrowth = (baseSeconds > 0.0) ? bestSeconds / baseSeconds : 0.0;
+            double countGrowth = (baseAllocationCount > 0) ? (double)stats.allocationCount / (double)baseAllocationCount : 0.0;
+            double bytesGrowth = (baseAllocationBytes > 0) ? (double)stats.allocationBytes / (double)baseAllocationBytes : 0.0;
+
+            bool isLinear = timeGrowth <= linear * SCALING_TIME_SLACK
+                && countGrowth <= linear * SCALING_COUNT_SLACK
+                && bytesGrowth <= linear * SCALING_BYTES_SLACK;
+
+            printf("%-11s %8zu %10.3f %12zu %14zu %8.2f %8.2f %8.2f%s\n",
+                SynthShapeName((SynthShape)shape),
+                stepSize,
+                bestSeconds * 1000.0,
+                stats.allocationCount,
+                stats.allocationBytes,
+                timeGrowth,
+                countGrowth,
+                bytesGrowth,
+                isLinear ? "" : "   SUPERLINEAR"
+            );
+
+            if (!isLinear)
+            {
+                status = 1;
+            }
+        }
+    }
+
+    printf("%s\n", status ? "FAIL: growth exceeded the linear bound" : "PASS: all shapes scale linearly");
+
+    return status;
+}
+
+static int RunShape(SynthShape shape, size_t size, size_t iterations, uint32_t seed, const char* directory, BenchResult* result)
+{
+    memset(result, 0, sizeof(BenchResult));
+    result->shape = shape;
+    result->size = size;
+    result->iterations = iterations;
+
+    char inputPath[1024];
+    char headerPath[1024];
+    char sourcePath[1024];
+    snprintf(inputPath, sizeof(inputPath), "%s/nkgen_bench_%s.xml", directory, SynthShapeName(shape));
+    snprintf(headerPath, sizeof(headerPath), "%s/nkgen_bench_%s.xml.h", directory, SynthShapeName(shape));
+    snprintf(sourcePath, sizeof(sourcePath), "%s/nkgen_bench_%s.xml.c", directory, SynthShapeName(shape));
+
+    size_t layoutSize = 0;
+    char* layout = SynthGenerateLayout(shape, size, seed, &layoutSize);
+
+    if (!layout || WriteFile(inputPath, layout, layoutSize))
+    {
+        fprintf(stderr, "Error: Could not write synthetic layout '%s'\n", inputPath);
+        free(layout);
+        return 1;
+    }
+
+    free(layout);
+
+    NkGenOptions options = {
+        .moduleName = "Bench",
+        .inputPath = inputPath,
+        .headerPath = headerPath,
+        .sourcePath = sourcePath,
+        .backend = backend
+    };
+
+    for (size_t phase = 0; phase < NKGEN_PHASE_COUNT; phase++)
+    {
+        result->minSeconds[phase] = -1.0;
+    }
+
+    /* one untimed warm up run, then the measured iterations */
+    for (size_t iteration = 0; iteration <= iterations; iteration++)
+    {
+        double phaseStart = nkgen_time_seconds();
+
+        char* input = NULL;
+        size_t inputSize = 0;
+
+        if (LoadFile(inputPath, &input, &inputSize))
+        {
+            fprintf(stderr, "Error: Could not load '%s'\n", inputPath);
+            return 1;
+        }
+
+        double loadSeconds = nkgen_time_seconds() - phaseStart;
+
+        NkGenOutput output;
+        NkGenResult generateResult = nkgen_generate(input, inputSize, &options, &output);
+        free(input);
+
+        if (generateResult != NKGEN_OK)
+        {
+            fprintf(stderr, "Error: Could not generate %s layout: %s\n", SynthShapeName(shape), nkgen_result_string(generateResult));
+            nkgen_free_output(&output);
+            return 1;
+        }
+
+        phaseStart = nkgen_time_seconds();
+
+        if (WriteFile(headerPath, output.header, output.headerSize) || WriteFile(sourcePath, output.source, output.sourceSize))
+        {
+            fprintf(stderr, "Error: Could not write generated files to '%s'\n", directory);
+            nkgen_free_output(&output);
+            return 1;
+        }
+
+        output.stats.phaseSeconds[NKGEN_PHASE_LOAD] = loadSeconds;
+        output.stats.phaseSeconds[NKGEN_PHASE_WRITE] = nkgen_time_seconds() - phaseStart;
+
+        if (iteration > 0)
+        {
+            for (size_t phase = 0; phase < NKGEN_PHASE_COUNT; phase++)
+            {
+                double seconds = output.stats.phaseSeconds[phase];
+
+                result->meanSeconds[phase] += seconds / (double)iterations;
+
+                if (result->minSeconds[phase] < 0.0 || seconds < result->minSeconds[phase])
+                {
+                    result->minSeconds[phase] = seconds;
+                }
+            }
+        }
+
+        result->inputSize = inputSize;
+        result->nodeCount = output.stats.nodeCount;
+        result->propertyCount = output.stats.propertyCount;
+        result->outputSize = output.headerSize + output.sourceSize;
+
+        nkgen_free_output(&output);
+    }
+
+    return 0;
+}
+
+static void PrintResult(const BenchResult* result)
+{
+    double totalSeconds = 0.0;
+    double totalMinSeconds = 0.0;
+    double megabytes = (double)result->inputSize / (1024.0 * 1024.0);
+    double kilonodes = (double)result->nodeCount / 1000.0;
+
+    for (size_t phase = 0; phase < NKGEN_PHASE_COUNT; phase++)
+    {
+        double seconds = result->meanSeconds[phase];
+
+        totalSeconds += seconds;
+        totalMinSeconds += result->minSeconds[phase];
+
+        printf("%-11s %-9s %-9s %10.3f %10.3f %10.1f %10.1f\n",
+            SynthShapeName(result->shape),
+            BackendName(backend),
+            nkgen_phase_name((NkGenPhase)phase),
+            seconds * 1000.0,
+            result->minSeconds[phase] * 1000.0,
+            (seconds > 0.0) ? megabytes / seconds : 0.0,
+            (seconds > 0.0) ? kilonodes / seconds : 0.0
+        );
+    }
+
+    printf("%-11s %-9s %-9s %10.3f %10.3f %10.1f %10.1f   (%zu bytes, %zu nodes, %zu properties)\n",
+        SynthShapeName(result->shape),
+        BackendName(backend),
+        "total",
+        totalSeconds * 1000.0,
+        totalMinSeconds * 1000.0,
+        (totalSeconds > 0.0) ? megabytes / totalSeconds : 0.0,
+        (totalSeconds > 0.0) ? kilonodes / totalSeconds : 0.0,
+        result->inputSize,
+        result->nodeCount,
+        result->propertyCount
+    );
+}
+
+static void WriteResultJson(FILE* file, const BenchResult* result)
+{
+    double totalSeconds = 0.0;
+
+    fprintf(file, "{\"shape\":\"%s\",\"backend\":\"%s\",\"size\":%zu,\"iterations\":%zu,\"input_bytes\":%zu,\"output_bytes\":%zu,\"nodes\":%zu,\"properties\":%zu,\"phases\":{",
+        SynthShapeName(result->shape),
+        BackendName(backend),
+        result->size,
+        result->iterations,
+        result->inputSize,
+        result->outputSize,
+        result->nodeCount,
+        result->propertyCount
+    );
+
+    for (size_t phase = 0; phase < NKGEN_PHASE_COUNT; phase++)
+    {
+        totalSeconds += result->meanSeconds[phase];
+
+        fprintf(file, "%s\"%s\":{\"mean_ms\":%.6f,\"min_ms\":%.6f}",
+            (phase == 0) ? "" : ",",
+            nkgen_phase_name((NkGenPhase)phase),
+            result->meanSeconds[phase] * 1000.0,
+            result->minSeconds[phase] * 1000.0
+        );
+    }
+
+    fprintf(file, "},\"total_ms\":%.6f,\"mb_per_s\":%.3f,\"nodes_per_s\":%.1f}\n",
+        totalSeconds * 1000.0,
+        (totalSeconds > 0.0) ? ((double)result->inputSize / (1024.0 * 1024.0)) / totalSeconds : 0.0,
+        (totalSeconds > 0.0) ? (double)result->nodeCount / totalSeconds : 0.0
+    );
+}
+
+static int LoadFile(const char* path, char** buffer, size_t* size)
+{
+    FILE *inputFileHandle = fopen(path, "rb");
+
+    if (!inputFileHandle) {
+        return 1;
+    }
+
+    fseek(inputFileHandle, 0, SEEK_END);
+    size_t fileSize = ftell(inputFileHandle);
+    fseek(inputFileHandle, 0, SEEK_SET);
+
+    char* fileBuffer = (char *)malloc(fileSize + 1);
+
+    if (!fileBuffer) {
+        fclose(inputFileHandle);
+        return 1;
+    }
+
+    fileSize = fread(fileBuffer, 1, fileSize, inputFileHandle);
+    fileBuffer[fileSize] = '\0';
+
+    fclose(inputFileHandle);
+
+    *buffer = fileBuffer;
+    *size = fileSize;
+
+    return 0;
+}
+
+static int WriteFile(const char* path, const char* contents, size_t size)
+{
+    FILE *outputFileHandle = fopen(path, "wb");
+
+    if (!outputFileHandle) {
+        return 1;
+    }
+
+    size_t written = fwrite(contents, 1, size, outputFileHandle);
+    fclose(outputFileHandle);
+
+    return (written == size) ? 0 : 1;
+}
+
+static const char* BackendName(NkGenBackend backend)
+{
+    switch (backend)
+    {
+        case NKGEN_BACKEND_TABLE:       return "table";
+        case NKGEN_BACKEND_PROTOTYPE:   return "prototype";
+        default:                        return "unrolled";
+    }
+}
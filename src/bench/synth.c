@@ -0,0 +1,312 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  synth.c
+** Module       :  nkgen_bench
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Deterministic synthetic layout generator
+**
+***************************************************************/
+
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <buffer/buffer.h>
+
+#include "synth.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define LONG_TEXT_WORDS     (256)
+#define QUOTED_VALUE_WORDS  (48)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static const char* shapeNames[SYNTH_SHAPE_COUNT] = {
+    [SYNTH_SHAPE_DEEP] = "deep",
+    [SYNTH_SHAPE_WIDE] = "wide",
+    [SYNTH_SHAPE_TEXT] = "text",
+    [SYNTH_SHAPE_ATTRIBUTES] = "attributes",
+    [SYNTH_SHAPE_QUOTED] = "quoted",
+    [SYNTH_SHAPE_MIXED] = "mixed",
+};
+
+static const char* words[] = {
+    "lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit",
+    "sed", "do", "eiusmod", "tempor", "incididunt", "ut", "labore", "et",
+    "dolore", "magna", "aliqua", "enim", "ad", "minim", "veniam", "quis"
+};
+
+static const char* colors[] = {
+    "Black", "White", "Red", "Green", "Blue", "LightGray", "#202020", "#3366ff", "#ff8800", "#00cc66"
+};
+
+static const char* panels[] = { "DockPanel", "StackPanel", "ScrollViewer" };
+
+static uint32_t randomState = 1;
+
+static OutputBuffer output;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static uint32_t NextRandom(void);
+static const char* PickWord(void);
+static const char* PickColor(void);
+
+static void WriteWords(size_t count);
+static void WriteViewAttributes(void);
+static void WriteButton(size_t depth, size_t index);
+static void WriteTextBlock(size_t depth, size_t textWords);
+static void WriteIndent(size_t depth);
+static size_t WriteMixed(size_t depth, size_t budget);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+char* SynthGenerateLayout(SynthShape shape, size_t size, uint32_t seed, size_t* length)
+{
+    randomState = seed ? seed : 1;
+
+    BufferInit(&output, 64 * 1024);
+
+    BufferPrintf(&output, "<Window Title=\"Synthetic %s layout\" Width=\"1280\" Height=\"800\">\n", SynthShapeName(shape));
+
+    switch (shape)
+    {
+        case SYNTH_SHAPE_DEEP:
+        {
+            for (size_t i = 0; i < size; i++)
+            {
+                WriteIndent(i + 1);
+                BufferPrintf(&output, "<%s", panels[i % 3]);
+                if (i % 3 == 1) BufferPrintf(&output, " Orientation=\"%s\"", (i % 2) ? "Vertical" : "Horizontal");
+                BufferPrintf(&output, " Margin=\"%zu\">\n", i % 8);
+            }
+
+            WriteTextBlock(size + 1, 4);
+
+            for (size_t i = size; i > 0; i--)
+            {
+                WriteIndent(i);
+                BufferPrintf(&output, "</%s>\n", panels[(i - 1) % 3]);
+            }
+        } break;
+
+        case SYNTH_SHAPE_WIDE:
+        {
+            BufferPrintf(&output, "    <StackPanel Orientation=\"Vertical\">\n");
+
+            for (size_t i = 0; i < size; i++)
+            {
+                WriteButton(2, i);
+            }
+
+            BufferPrintf(&output, "    </StackPanel>\n");
+        } break;
+
+        case SYNTH_SHAPE_TEXT:
+        {
+            BufferPrintf(&output, "    <StackPanel Orientation=\"Vertical\">\n");
+
+            for (size_t i = 0; i < size; i++)
+            {
+                WriteTextBlock(2, LONG_TEXT_WORDS);
+            }
+
+            BufferPrintf(&output, "    </StackPanel>\n");
+        } break;
+
+        case SYNTH_SHAPE_ATTRIBUTES:
+        {
+            BufferPrintf(&output, "    <StackPanel Orientation=\"Vertical\">\n");
+
+            for (size_t i = 0; i < size; i++)
+            {
+                WriteIndent(2);
+                BufferPrintf(&output, "<Button");
+                WriteViewAttributes();
+                BufferPrintf(&output, " Foreground=\"%s\" Click=\"OnClick%zu\">Button %zu</Button>\n", PickColor(), i % 16, i);
+            }
+
+            BufferPrintf(&output, "    </StackPanel>\n");
+        } break;
+
+        case SYNTH_SHAPE_QUOTED:
+        {
+            BufferPrintf(&output, "    <StackPanel Orientation=\"Vertical\">\n");
+
+            for (size_t i = 0; i < size; i++)
+            {
+                WriteIndent(2);
+                BufferPrintf(&output, "<TextBlock Text=\"");
+                WriteWords(QUOTED_VALUE_WORDS);
+                BufferPrintf(&output, "\" Foreground=\"%s\"/>\n", PickColor());
+            }
+
+            BufferPrintf(&output, "    </StackPanel>\n");
+        } break;
+
+        case SYNTH_SHAPE_MIXED:
+        default:
+        {
+            BufferPrintf(&output, "    <DockPanel LastChildFill=\"true\">\n");
+
+            size_t remaining = size;
+            while (remaining > 0)
+            {
+                remaining -= WriteMixed(2, remaining);
+            }
+
+            BufferPrintf(&output, "    </DockPanel>\n");
+        } break;
+    }
+
+    BufferPrintf(&output, "</Window>\n");
+
+    return BufferRelease(&output, length);
+}
+
+const char* SynthShapeName(SynthShape shape)
+{
+    return (shape < SYNTH_SHAPE_COUNT) ? shapeNames[shape] : "unknown";
+}
+
+SynthShape SynthShapeFromName(const char* name)
+{
+    for (size_t i = 0; i < SYNTH_SHAPE_COUNT; i++)
+    {
+        if (strcmp(shapeNames[i], name) == 0)
+        {
+            return (SynthShape)i;
+        }
+    }
+
+    return SYNTH_SHAPE_COUNT;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static uint32_t NextRandom(void)
+{
+    /* xorshift32, identical on every platform */
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+static const char* PickWord(void)
+{
+    return words[NextRandom() % (sizeof(words) / sizeof(words[0]))];
+}
+
+static const char* PickColor(void)
+{
+    return colors[NextRandom() % (sizeof(colors) / sizeof(colors[0]))];
+}
+
+static void WriteWords(size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        BufferPrintf(&output, (i == 0) ? "%s" : " %s", PickWord());
+    }
+}
+
+static void WriteViewAttributes(void)
+{
+    static const char* horizontal[] = { "Left", "Center", "Right", "Stretch" };
+    static const char* vertical[] = { "Top", "Center", "Bottom", "Stretch" };
+    static const char* dock[] = { "Left", "Top", "Right", "Bottom" };
+
+    BufferPrintf(&output, " Width=\"%u\" Height=\"%u\" Margin=\"%u\" Background=\"%s\" HorizontalAlignment=\"%s\" VerticalAlignment=\"%s\" DockPanel.Dock=\"%s\"",
+        40 + NextRandom() % 200,
+        20 + NextRandom() % 40,
+        NextRandom() % 16,
+        PickColor(),
+        horizontal[NextRandom() % 4],
+        vertical[NextRandom() % 4],
+        dock[NextRandom() % 4]
+    );
+}
+
+static void WriteButton(size_t depth, size_t index)
+{
+    WriteIndent(depth);
+    BufferPrintf(&output, "<Button Background=\"%s\" Click=\"OnClick%zu\">Button %zu</Button>\n", PickColor(), index % 16, index);
+}
+
+static void WriteTextBlock(size_t depth, size_t textWords)
+{
+    WriteIndent(depth);
+    BufferPrintf(&output, "<TextBlock Foreground=\"%s\">", PickColor());
+    WriteWords(textWords);
+    BufferPrintf(&output, "</TextBlock>\n");
+}
+
+static void WriteIndent(size_t depth)
+{
+    /* cap the indent so deep layouts stay linear in size */
+    for (size_t i = 0; i < depth && i < 32; i++)
+    {
+        BufferWrite(&output, "    ", 4);
+    }
+}
+
+static size_t WriteMixed(size_t depth, size_t budget)
+{
+    uint32_t kind = NextRandom() % 4;
+
+    if (kind == 0 && depth < 24 && budget > 1)
+    {
+        const char* panel = panels[NextRandom() % 3];
+
+        WriteIndent(depth);
+        BufferPrintf(&output, "<%s Background=\"%s\" Margin=\"%u\">\n", panel, PickColor(), NextRandom() % 8);
+
+        size_t used = 1;
+        size_t children = 1 + NextRandom() % 6;
+
+        for (size_t i = 0; i < children && used < budget; i++)
+        {
+            used += WriteMixed(depth + 1, budget - used);
+        }
+
+        WriteIndent(depth);
+        BufferPrintf(&output, "</%s>\n", panel);
+
+        return used;
+    }
+    else if (kind == 1)
+    {
+        WriteTextBlock(depth, 1 + NextRandom() % 12);
+    }
+    else
+    {
+        WriteButton(depth, NextRandom());
+    }
+
+    return 1;
+}
@@ -0,0 +1,53 @@
+/***************************************************************
+**
+** NanoKit Tool Header File
+**
+** File         :  synth.h
+** Module       :  nkgen_bench
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Deterministic synthetic layout generator
+**
+***************************************************************/
+
+#ifndef SYNTH_H
+#define SYNTH_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef enum
+{
+    SYNTH_SHAPE_DEEP,           /* one chain of nested panels, size levels deep */
+    SYNTH_SHAPE_WIDE,           /* one panel with size buttons */
+    SYNTH_SHAPE_TEXT,           /* size text blocks with long text content */
+    SYNTH_SHAPE_ATTRIBUTES,     /* size views carrying every property they accept */
+    SYNTH_SHAPE_QUOTED,         /* size views with long quoted values containing spaces */
+    SYNTH_SHAPE_MIXED,          /* a randomly branching tree of size views */
+    SYNTH_SHAPE_COUNT
+} SynthShape;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* Returns NUL terminated markup that the caller must free, the same seed always gives the same layout */
+char* SynthGenerateLayout(SynthShape shape, size_t size, uint32_t seed, size_t* length);
+
+const char* SynthShapeName(SynthShape shape);
+SynthShape SynthShapeFromName(const char* name);
+
+#endif /* SYNTH_H */
@@ -0,0 +1,302 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  binding.c
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen {Binding Path} collection
+**
+***************************************************************/
+
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stats/alloc.h>
+
+#include <diagnostics/diagnostics.h>
+
+#include "binding.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define BINDING_PREFIX "{Binding"
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static BindingPath* paths = NULL;
+static size_t pathCount = 0;
+static size_t pathCapacity = 0;
+
+static BindingSite* sites = NULL;
+static size_t siteCount = 0;
+static size_t siteCapacity = 0;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static bool CollectNode(TreeNode* node, const TreeNode* deferred);
+static bool AddSite(TreeNode* node, NodeProperty* property, const TreeNode* deferred);
+static bool ParsePath(const char* value, char* path, size_t size);
+static size_t FindPath(const char* name);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool IsBinding(const char* value)
+{
+    size_t length = strlen(BINDING_PREFIX);
+
+    if (!value || strncmp(value, BINDING_PREFIX, length) != 0) return false;
+
+    return value[length] == ' ' || value[length] == '\t' || value[length] == '}';
+}
+
+bool CollectBindings(TreeNode* rootNode)
+{
+    ClearBindings();
+
+    if (!rootNode) return true;
+
+    return CollectNode(rootNode, NULL);
+}
+
+void ClearBindings(void)
+{
+    for (size_t i = 0; i < pathCount; i++)
+    {
+        free(paths[i].name);
+    }
+
+    free(paths);
+    free(sites);
+
+    paths = NULL;
+    pathCount = 0;
+    pathCapacity = 0;
+
+    sites = NULL;
+    siteCount = 0;
+    siteCapacity = 0;
+}
+
+size_t GetBindingPathCount(void)
+{
+    return pathCount;
+}
+
+const BindingPath* GetBindingPath(size_t index)
+{
+    return (index < pathCount) ? &paths[index] : NULL;
+}
+
+size_t GetBindingSiteCount(void)
+{
+    return siteCount;
+}
+
+const BindingSite* GetBindingSite(size_t index)
+{
+    return (index < siteCount) ? &sites[index] : NULL;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static bool CollectNode(TreeNode* node, const TreeNode* deferred)
+{
+    bool valid = true;
+
+    /* siblings are walked in a loop, only depth recurses */
+    for (; node != NULL; node = node->sibling)
+    {
+        const TreeNode* nodeDeferred = node->deferred ? node : deferred;
+
+        for (NodeProperty* property = node->properties; property != NULL; property = property->next)
+        {
+            if (IsBinding(property->value) && !AddSite(node, property, nodeDeferred))
+            {
+                valid = false;
+            }
+        }
+
+        if (node->child && !CollectNode(node->child, nodeDeferred))
+        {
+            valid = false;
+        }
+    }
+
+    return valid;
+}
+
+static bool AddSite(TreeNode* node, NodeProperty* property, const TreeNode* deferred)
+{
+    char name[128];
+
+    if (node->repeatCount)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, property->line, property->column, "'%s' cannot be used on the repeated element '%s', a binding targets a single field", property->value, node->instanceName);
+        return false;
+    }
+
+    if (node->component)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, property->line, property->column, "'%s' cannot be used on the UserControl '%s', bind inside the component instead", property->value, node->instanceName);
+        return false;
+    }
+
+    if (!ParsePath(property->value, name, sizeof(name)))
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, property->line, property->column, "malformed binding '%s', expected {Binding Path} with a C identifier path", property->value);
+        return false;
+    }
+
+    bool isInherited = false;
+    PropertyType type = ResolvePropertyType(node->className, property->key, &isInherited);
+
+    size_t pathIndex = FindPath(name);
+
+    if (pathIndex == BINDING_NONE)
+    {
+        if (pathCount == pathCapacity)
+        {
+            size_t capacity = pathCapacity ? pathCapacity * 2 : 16;
+            BindingPath* grown = (BindingPath*)realloc(paths, capacity * sizeof(BindingPath));
+
+            if (!grown) return false;
+
+            paths = grown;
+            pathCapacity = capacity;
+        }
+
+        pathIndex = pathCount++;
+
+        paths[pathIndex].name = (char*)malloc(strlen(name) + 1);
+
+        if (!paths[pathIndex].name)
+        {
+            pathCount--;
+            return false;
+        }
+
+        strcpy(paths[pathIndex].name, name);
+        paths[pathIndex].type = type;
+        paths[pathIndex].firstSite = BINDING_NONE;
+        paths[pathIndex].lastSite = BINDING_NONE;
+    }
+    else if (paths[pathIndex].type != type)
+    {
+        const BindingSite* first = &sites[paths[pathIndex].firstSite];
+
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, property->line, property->column,
+            "binding '%s' is bound to a %s here but to a %s by '%s' at %u:%u",
+            name,
+            GetTypeCodeName(type),
+            GetTypeCodeName(paths[pathIndex].type),
+            first->property->key,
+            (unsigned)first->property->line,
+            (unsigned)first->property->column
+        );
+        return false;
+    }
+
+    if (siteCount == siteCapacity)
+    {
+        size_t capacity = siteCapacity ? siteCapacity * 2 : 16;
+        BindingSite* grown = (BindingSite*)realloc(sites, capacity * sizeof(BindingSite));
+
+        if (!grown) return false;
+
+        sites = grown;
+        siteCapacity = capacity;
+    }
+
+    size_t siteIndex = siteCount++;
+
+    sites[siteIndex].node = node;
+    sites[siteIndex].property = property;
+    sites[siteIndex].fieldName = TranslatePropertyName(node->className, property->key);
+    sites[siteIndex].isInherited = isInherited;
+    sites[siteIndex].deferred = deferred;
+    sites[siteIndex].path = pathIndex;
+    sites[siteIndex].nextSite = BINDING_NONE;
+
+    if (paths[pathIndex].lastSite == BINDING_NONE)
+    {
+        paths[pathIndex].firstSite = siteIndex;
+    }
+    else
+    {
+        sites[paths[pathIndex].lastSite].nextSite = siteIndex;
+    }
+
+    paths[pathIndex].lastSite = siteIndex;
+
+    return true;
+}
+
+static bool ParsePath(const char* value, char* path, size_t size)
+{
+    /* {Binding Name} or {Binding Path=Name}, surrounding blanks allowed */
+    const char* cursor = value + strlen(BINDING_PREFIX);
+
+    while (*cursor == ' ' || *cursor == '\t') cursor++;
+
+    if (strncmp(cursor, "Path=", 5) == 0)
+    {
+        cursor += 5;
+    }
+
+    size_t length = 0;
+
+    while ((cursor[length] >= 'a' && cursor[length] <= 'z') ||
+           (cursor[length] >= 'A' && cursor[length] <= 'Z') ||
+           (cursor[length] == '_') ||
+           (length > 0 && cursor[length] >= '0' && cursor[length] <= '9'))
+    {
+        length++;
+    }
+
+    if (length == 0 || length >= size) return false;
+
+    memcpy(path, cursor, length);
+    path[length] = '\0';
+
+    cursor += length;
+
+    while (*cursor == ' ' || *cursor == '\t') cursor++;
+
+    return cursor[0] == '}' && cursor[1] == '\0';
+}
+
+static size_t FindPath(const char* name)
+{
+    for (size_t i = 0; i < pathCount; i++)
+    {
+        if (strcmp(paths[i].name, name) == 0)
+        {
+            return i;
+        }
+    }
+
+    return BINDING_NONE;
+}
@@ -0,0 +1,79 @@
+/***************************************************************
+**
+** NanoKit Tool Header File
+**
+** File         :  binding.h
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen {Binding Path} collection
+**
+***************************************************************/
+
+#ifndef BINDING_H
+#define BINDING_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <parser/parser.h>
+#include <translator/translator.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define BINDING_NONE ((size_t)-1)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* One bound attribute */
+typedef struct
+{
+    const TreeNode* node;
+    const NodeProperty* property;
+    const char* fieldName;      /* translated property name, under .view when inherited */
+    bool isInherited;
+
+    const TreeNode* deferred;   /* nearest deferred node at or above the site, NULL if _Create builds it */
+
+    size_t path;                /* index of the path it is bound to */
+    size_t nextSite;            /* next site of the same path, BINDING_NONE at the end */
+} BindingSite;
+
+/* One view model field, its index is also its dirty bit */
+typedef struct
+{
+    char* name;
+    PropertyType type;
+
+    size_t firstSite;
+    size_t lastSite;
+} BindingPath;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* True for "{Binding ...}", writers leave these attributes to the binding code */
+bool IsBinding(const char* value);
+
+/* Gathers the bindings of a validated tree, reports malformed paths and type conflicts */
+bool CollectBindings(TreeNode* rootNode);
+void ClearBindings(void);
+
+size_t GetBindingPathCount(void);
+const BindingPath* GetBindingPath(size_t index);
+
+size_t GetBindingSiteCount(void);
+const BindingSite* GetBindingSite(size_t index);
+
+#endif /* BINDING_H */
@@ -0,0 +1,165 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  buffer.c
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen growable output buffer
+**
+***************************************************************/
+
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+#include <stats/alloc.h>
+
+#include "buffer.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static bool Reserve(OutputBuffer* buffer, size_t length);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void BufferInit(OutputBuffer* buffer, size_t initialSize)
+{
+    buffer->size = (initialSize > 0) ? initialSize : 1;
+    buffer->position = 0;
+    buffer->failed = false;
+    buffer->data = (char*)malloc(buffer->size);
+
+    if (!buffer->data)
+    {
+        buffer->size = 0;
+        buffer->failed = true;
+        return;
+    }
+
+    buffer->data[0] = '\0';
+}
+
+void BufferFree(OutputBuffer* buffer)
+{
+    free(buffer->data);
+    buffer->data = NULL;
+    buffer->size = 0;
+    buffer->position = 0;
+}
+
+void BufferPrintf(OutputBuffer* buffer, const char* format, ...)
+{
+    if (buffer->failed) return;
+
+    va_list arguments;
+    va_start(arguments, format);
+
+    va_list retryArguments;
+    va_copy(retryArguments, arguments);
+
+    int length = vsnprintf(buffer->data + buffer->position, buffer->size - buffer->position, format, arguments);
+
+    if (length >= 0 && (size_t)length >= buffer->size - buffer->position)
+    {
+        /* did not fit, grow and format again */
+        if (Reserve(buffer, (size_t)length))
+        {
+            vsnprintf(buffer->data + buffer->position, buffer->size - buffer->position, format, retryArguments);
+        }
+    }
+
+    if (length >= 0 && !buffer->failed)
+    {
+        buffer->position += (size_t)length;
+    }
+
+    va_end(retryArguments);
+    va_end(arguments);
+}
+
+void BufferWrite(OutputBuffer* buffer, const char* data, size_t length)
+{
+    if (buffer->failed || !Reserve(buffer, length)) return;
+
+    memcpy(buffer->data + buffer->position, data, length);
+    buffer->position += length;
+    buffer->data[buffer->position] = '\0';
+}
+
+char* BufferRelease(OutputBuffer* buffer, size_t* size)
+{
+    char* data = buffer->failed ? NULL : buffer->data;
+
+    if (buffer->failed)
+    {
+        free(buffer->data);
+    }
+
+    if (size)
+    {
+        *size = data ? buffer->position : 0;
+    }
+
+    buffer->data = NULL;
+    buffer->size = 0;
+    buffer->position = 0;
+
+    return data;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static bool Reserve(OutputBuffer* buffer, size_t length)
+{
+    if (buffer->failed) return false;
+
+    size_t required = buffer->position + length + 1;
+
+    if (required <= buffer->size) return true;
+
+    size_t newSize = buffer->size;
+    while (newSize < required)
+    {
+        newSize *= 2;
+    }
+
+    char* newData = (char*)realloc(buffer->data, newSize);
+
+    if (!newData)
+    {
+        buffer->failed = true;
+        return false;
+    }
+
+    buffer->data = newData;
+    buffer->size = newSize;
+
+    return true;
+}
@@ -0,0 +1,54 @@
+/***************************************************************
+**
+** NanoKit Tool Header File
+**
+** File         :  buffer.h
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen growable output buffer
+**
+***************************************************************/
+
+#ifndef BUFFER_H
+#define BUFFER_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef struct
+{
+    char* data;         /* always NUL terminated once initialised */
+    size_t size;        /* allocated bytes */
+    size_t position;    /* bytes written */
+    bool failed;        /* an allocation failed, further writes are dropped */
+} OutputBuffer;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+void BufferInit(OutputBuffer* buffer, size_t initialSize);
+void BufferFree(OutputBuffer* buffer);
+
+void BufferPrintf(OutputBuffer* buffer, const char* format, ...);
+void BufferWrite(OutputBuffer* buffer, const char* data, size_t length);
+
+/* Hands the contents to the caller, who must free them */
+char* BufferRelease(OutputBuffer* buffer, size_t* size);
+
+#endif /* BUFFER_H */
@@ -0,0 +1,189 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  diagnostics.c
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen leveled diagnostics sink
+**
+***************************************************************/
+
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+#include <stats/alloc.h>
+
+#include "diagnostics.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static DiagnosticLevel maximumLevel = DIAGNOSTIC_ERROR;
+
+static Diagnostic* diagnostics = NULL;
+static size_t diagnosticCount = 0;
+static size_t diagnosticCapacity = 0;
+static size_t errorCount = 0;
+
+static const char* contextFile = NULL;
+static uint32_t contextLine = 0;
+static uint32_t contextColumn = 0;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static void Record(DiagnosticLevel level, const char* file, uint32_t line, uint32_t column, const char* format, va_list arguments);
+static char* CopyString(const char* string);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void DiagnosticsBegin(DiagnosticLevel level)
+{
+    DiagnosticsFree(diagnostics, diagnosticCount);
+
+    diagnostics = NULL;
+    diagnosticCount = 0;
+    diagnosticCapacity = 0;
+    errorCount = 0;
+
+    maximumLevel = level;
+
+    DiagnosticsSetContext(NULL, 0, 0);
+}
+
+bool DiagnosticsEnabled(DiagnosticLevel level)
+{
+    return level <= maximumLevel || level == DIAGNOSTIC_ERROR;
+}
+
+void DiagnosticsSetContext(const char* file, uint32_t line, uint32_t column)
+{
+    contextFile = file;
+    contextLine = line;
+    contextColumn = column;
+}
+
+void DiagnosticsReport(DiagnosticLevel level, const char* format, ...)
+{
+    if (!DiagnosticsEnabled(level)) return;
+
+    va_list arguments;
+    va_start(arguments, format);
+    Record(level, contextFile, contextLine, contextColumn, format, arguments);
+    va_end(arguments);
+}
+
+void DiagnosticsReportAt(DiagnosticLevel level, const char* file, uint32_t line, uint32_t column, const char* format, ...)
+{
+    if (!DiagnosticsEnabled(level)) return;
+
+    va_list arguments;
+    va_start(arguments, format);
+    Record(level, file, line, column, format, arguments);
+    va_end(arguments);
+}
+
+size_t DiagnosticsErrorCount(void)
+{
+    return errorCount;
+}
+
+Diagnostic* DiagnosticsTake(size_t* count)
+{
+    Diagnostic* taken = diagnostics;
+    *count = diagnosticCount;
+
+    diagnostics = NULL;
+    diagnosticCount = 0;
+    diagnosticCapacity = 0;
+
+    return taken;
+}
+
+void DiagnosticsFree(Diagnostic* list, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        free(list[i].file);
+        free(list[i].message);
+    }
+
+    free(list);
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static void Record(DiagnosticLevel level, const char* file, uint32_t line, uint32_t column, const char* format, va_list arguments)
+{
+    if (level == DIAGNOSTIC_ERROR)
+    {
+        errorCount++;
+    }
+
+    if (diagnosticCount == diagnosticCapacity)
+    {
+        size_t newCapacity = diagnosticCapacity ? diagnosticCapacity * 2 : 16;
+        Diagnostic* newDiagnostics = (Diagnostic*)realloc(diagnostics, newCapacity * sizeof(Diagnostic));
+
+        if (!newDiagnostics) return;
+
+        diagnostics = newDiagnostics;
+        diagnosticCapacity = newCapacity;
+    }
+
+    va_list lengthArguments;
+    va_copy(lengthArguments, arguments);
+    int length = vsnprintf(NULL, 0, format, lengthArguments);
+    va_end(lengthArguments);
+
+    if (length < 0) return;
+
+    char* message = (char*)malloc((size_t)length + 1);
+
+    if (!message) return;
+
+    vsnprintf(message, (size_t)length + 1, format, arguments);
+
+    Diagnostic* diagnostic = &diagnostics[diagnosticCount++];
+    diagnostic->level = level;
+    diagnostic->file = file ? CopyString(file) : NULL;
+    diagnostic->line = line;
+    diagnostic->column = column;
+    diagnostic->message = message;
+}
+
+static char* CopyString(const char* string)
+{
+    char* copy = (char*)malloc(strlen(string) + 1);
+
+    if (copy)
+    {
+        strcpy(copy, string);
+    }
+
+    return copy;
+}
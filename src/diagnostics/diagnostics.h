@@ -0,0 +1,73 @@
+/***************************************************************
+**
+** NanoKit Tool Header File
+**
+** File         :  diagnostics.h
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen leveled diagnostics sink
+**
+***************************************************************/
+
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* Ordered by verbosity, errors are always kept */
+typedef enum
+{
+    DIAGNOSTIC_ERROR,
+    DIAGNOSTIC_WARNING,
+    DIAGNOSTIC_INFO,
+    DIAGNOSTIC_DEBUG
+} DiagnosticLevel;
+
+typedef struct
+{
+    DiagnosticLevel level;
+    char* file;         /* NULL when the message has no source position */
+    uint32_t line;      /* 1 based, 0 if unknown */
+    uint32_t column;    /* 1 based, 0 if unknown */
+    char* message;
+} Diagnostic;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* Drops collected diagnostics and keeps levels up to maximumLevel from now on */
+void DiagnosticsBegin(DiagnosticLevel maximumLevel);
+
+/* Checked before formatting, so disabled levels cost nothing */
+bool DiagnosticsEnabled(DiagnosticLevel level);
+
+/* Position used by DiagnosticsReport, set by code that has no node to hand to the writers */
+void DiagnosticsSetContext(const char* file, uint32_t line, uint32_t column);
+
+void DiagnosticsReport(DiagnosticLevel level, const char* format, ...);
+void DiagnosticsReportAt(DiagnosticLevel level, const char* file, uint32_t line, uint32_t column, const char* format, ...);
+
+size_t DiagnosticsErrorCount(void);
+
+/* Hands the collected diagnostics to the caller, release them with DiagnosticsFree */
+Diagnostic* DiagnosticsTake(size_t* count);
+void DiagnosticsFree(Diagnostic* diagnostics, size_t count);
+
+#endif /* DIAGNOSTICS_H */
@@ -19,9 +19,19 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <stats/alloc.h>
+
 #include <xml/xml.h>
 
 #include <translator/translator.h>
+#include <binding/binding.h>
+#include <theme/theme.h>
+#include <items/items.h>
+#include <layout/layout.h>
+#include <lookup/lookup.h>
+#include <route/route.h>
+#include <members/members.h>
+#include <diagnostics/diagnostics.h>
 
 #include "header.h"
 
@@ -37,50 +47,47 @@
 ** MARK: STATIC VARIABLES
 ***************************************************************/
 
-static char* outputBuffer = NULL;
-static size_t outputBufferSize = 0;
-static size_t positionInFile = 0;
+static OutputBuffer output;
 
 static char moduleNameBuffer[256];
 static char moduleNameUpper[256];
 
+/* UserControl classes already included, each header is pulled in once */
+static const char** includedComponents = NULL;
+static size_t includedComponentCount = 0;
+
 /***************************************************************
 ** MARK: STATIC FUNCTION DEFS
 ***************************************************************/
 
 void DefineObject(TreeNode* node);
 void DefineCallbacks(TreeNode* node);
+void DefineDeferred(TreeNode* node, bool declareFunctions);
+static bool HasDeferred(TreeNode* node);
+static void DefineViewModel(void);
+static void DeclareSetters(void);
+static void DefineThemes(void);
+static void DefineRows(void);
+static void DefineViewIds(void);
+static void DefineEvents(void);
+static void IncludeComponents(const TreeNode* node, bool namedOnly);
+static void SetModuleName(const char* moduleName);
+static void DefineStruct(TreeNode* rootNode, bool opaque);
+static void DefineMember(const TreeNode* node);
+static void DefineMembers(void);
+static void DeclareAccessors(TreeNode* node);
 
 /***************************************************************
 ** MARK: PUBLIC FUNCTIONS
 ***************************************************************/
 
-void WriteHeaderFile(const char* path, const char* moduleName, TreeNode* fileContents)
+char* GenerateHeaderFile(const char* path, const char* moduleName, TreeNode* fileContents, bool opaque, bool footprint, size_t* size)
 {   
-    if (outputBuffer != NULL) 
-    {
-        free(outputBuffer);
-    }
-
-    outputBufferSize = 1024 * 1024; // 1 MB
-    outputBuffer = (char*)malloc(outputBufferSize);
-    if (outputBuffer == NULL) {
-        fprintf(stderr, "Error: Could not allocate memory for output buffer\n");
-        exit(1);
-    }
-
-    sprintf(moduleNameBuffer, "%s", moduleName);
-    
-    for (size_t i = 0; moduleName[i] != '\0'; i++) {
-        moduleNameUpper[i] = (moduleName[i] >= 'a' && moduleName[i] <= 'z') ? moduleName[i] - 32 : moduleName[i];
-    }
-    moduleNameUpper[strlen(moduleName)] = '\0';
+    BufferInit(&output, 64 * 1024);
 
-    const char* moduleType = TranslateClassName(fileContents->className);
+    SetModuleName(moduleName);
 
-    /* BEGIN STRUCT DEFINITION */
-
-    positionInFile = snprintf(outputBuffer, outputBufferSize, 
+    BufferPrintf(&output, 
 "/***************************************************************\n\
 **\n\
 ** NanoKit Generated Header File\n\
@@ -96,67 +103,249 @@ void WriteHeaderFile(const char* path, const char* moduleName, TreeNode* fileCon
 #include <nanowin.h>\n\
 #include <views/views.h>\n\
 \n\
-typedef struct\n\
-{\n\
-    /* Base object */\n\
-    %s super;\n\
-\n\
-    /* Child views */\n\
 ",
         path,
         moduleName,
         moduleNameUpper,
-        moduleNameUpper,
-        moduleType
+        moduleNameUpper
     );
 
-    TreeNode* currentNode = fileContents->child;
+    if (opaque)
+    {
+        BufferPrintf(&output, "#define %s_XML_OPAQUE\n\n", moduleNameUpper);
+    }
+
+    /* an opaque header only needs the components handed out by an accessor */
+    IncludeComponents(fileContents, opaque);
 
-    while (currentNode != NULL)
+    if (includedComponentCount > 0)
     {
-        DefineObject(currentNode);
-        currentNode = currentNode->sibling;
+        BufferPrintf(&output, "\n");
+
+        free(includedComponents);
+        includedComponents = NULL;
+        includedComponentCount = 0;
     }
 
-    /* END STRUCT DEFINITION */
+    if (GetBindingPathCount() > 0 && !opaque)
+    {
+        DefineViewModel();
+    }
 
-   positionInFile += snprintf(outputBuffer + positionInFile, outputBufferSize - positionInFile, 
-"} %s_t;\n\
-\n\
+    if (GetThemeCount() > 0)
+    {
+        DefineThemes();
+    }
+
+    if (GetListCount() > 0)
+    {
+        DefineRows();
+    }
+
+    if (GetViewIdCount() > 0)
+    {
+        DefineViewIds();
+    }
+
+    if (GetEventCount() > 0)
+    {
+        DefineEvents();
+    }
+
+    if (opaque)
+    {
+        /* the members only live in the module source, layout edits leave this header untouched */
+        BufferPrintf(&output, "/* Opaque Module - Defined in the Generated Source, Allocate %s_Size() Bytes */\ntypedef struct %s_s %s_t;\n", moduleName, moduleName, moduleName);
+    }
+    else
+    {
+        DefineStruct(fileContents, false);
+    }
+
+    BufferPrintf(&output, 
+"\n\
 /* Module Functions - Implementations Generated from XML */\n\
 bool %s_Create(%s_t* this);\n\
 void %s_Destroy(%s_t* this);\n\
-\n\
-/* Callback Functions - Implemented in User Code */\n\
 ",
         moduleName,
         moduleName,
         moduleName,
-        moduleName,
         moduleName
     );
 
+    if (opaque)
+    {
+        BufferPrintf(&output, "size_t %s_Size(void);\n", moduleName);
+
+        BufferPrintf(&output, "\n/* Named Views - Deferred Ones Are Only Built Once Realized */\n%s* %s_GetRoot(%s_t* this);\n", TranslateClassName(fileContents->className), moduleName, moduleName);
+        DeclareAccessors(fileContents->child);
+    }
+
+    if (HasDeferred(fileContents))
+    {
+        BufferPrintf(&output, "\n/* Deferred Subtrees - Built on First Use, Realizing Any Deferred Ancestor First */\n");
+        DefineDeferred(fileContents, true);
+    }
+
+    if (GetBindingPathCount() > 0)
+    {
+        DeclareSetters();
+    }
+
+    if (GetThemeCount() > 0)
+    {
+        BufferPrintf(&output,
+            "\n/* Themes - Rewrites Every Themed Field From the Resource Table, _Create Applies the First Theme */\nvoid %s_SetTheme(%s_t* this, %s_Theme_t theme);\n",
+            moduleName,
+            moduleName,
+            moduleName
+        );
+    }
+
+    if (GetViewIdCount() > 0)
+    {
+        BufferPrintf(&output,
+            "\n/* View IDs - _FindByName Gives %s_ViewCount for an Unknown Name, a Repeated View's ID Is Its First Element */\n%s_ViewId_t %s_FindByName(const char* name);\nvoid* %s_GetView(%s_t* this, %s_ViewId_t id);\n",
+            moduleName,
+            moduleName,
+            moduleName,
+            moduleName,
+            moduleName,
+            moduleName
+        );
+    }
+
+    if (GetEventCount() > 0)
+    {
+        BufferPrintf(&output,
+            "\n/* Events - Routed Through a Static Table, a NULL Sender Is the View Itself, False if the View Does Not Handle the Event */\n#include <stdbool.h>\n\nbool %s_Dispatch(%s_t* this, %s_ViewId_t id, %s_Event_t event, void* sender);\n",
+            moduleName,
+            moduleName,
+            moduleName,
+            moduleName
+        );
+    }
+
+    if (footprint)
+    {
+        BufferPrintf(&output,
+"\n\
+/* Footprint - Member Sizes in Declaration Order, total Receives the Struct Size if Not NULL, Their Types Are Listed in the Footprint Manifest */\n\
+#include <stddef.h>\n\
+\n\
+#ifndef NKGEN_FOOTPRINT_T\n\
+#define NKGEN_FOOTPRINT_T\n\
+typedef struct\n\
+{\n\
+\tconst char* name;\n\
+\tsize_t offset;\n\
+\tsize_t size;\n\
+} nkgenFootprint_t;\n\
+#endif\n\
+size_t %s_GetFootprint(const nkgenFootprint_t** members, size_t* total);\n\
+",
+            moduleName
+        );
+    }
+
+    if (GetListCount() > 0)
+    {
+        BufferPrintf(&output, "\n/* Virtualized Lists - Only the Visible Window of Items Is Bound to Rows */\n");
+
+        for (size_t i = 0; i < GetListCount(); i++)
+        {
+            const char* name = GetList(i)->instanceName;
+
+            BufferPrintf(&output,
+"void %s_SetItemCount_%s(%s_t* this, size_t itemCount);\n\
+void %s_ScrollTo_%s(%s_t* this, size_t firstItem);\n\
+void %s_RefreshItems_%s(%s_t* this);\n\
+",
+                moduleName, name, moduleName,
+                moduleName, name, moduleName,
+                moduleName, name, moduleName
+            );
+        }
+    }
+
+    BufferPrintf(&output, "\n/* Callback Functions - Implemented in User Code */\n");
+
     DefineCallbacks(fileContents);
 
     /* CALLBACK DEFINITIONS */
 
-    positionInFile += snprintf(outputBuffer + positionInFile, outputBufferSize - positionInFile,
+    BufferPrintf(&output,
         "\n\
 #endif /*%s_XML_H*/\n",
         moduleNameUpper
     );
 
-    FILE *headerFile = fopen(path, "w");
-    
-    if (!headerFile) {
-        fprintf(stderr, "Error: Could not open header file for writing\n");
-        return;
+    return BufferRelease(&output, size);
+}
+
+char* GenerateModuleStruct(const char* moduleName, TreeNode* fileContents, size_t* size)
+{
+    BufferInit(&output, 16 * 1024);
+
+    SetModuleName(moduleName);
+
+    /* the module source and its chunks may share one translation unit in a unity build */
+    BufferPrintf(&output,
+"/* Module Struct - Kept Out of the Opaque Header */\n\
+#ifndef %s_XML_STRUCT\n\
+#define %s_XML_STRUCT\n\
+\n\
+",
+        moduleNameUpper,
+        moduleNameUpper
+    );
+
+    IncludeComponents(fileContents, false);
+
+    if (includedComponentCount > 0)
+    {
+        /* a component is embedded by value, so its struct has to be complete here */
+        for (size_t i = 0; i < includedComponentCount; i++)
+        {
+            char componentUpper[256];
+            size_t length = 0;
+
+            for (; includedComponents[i][length] != '\0' && length < sizeof(componentUpper) - 1; length++)
+            {
+                char c = includedComponents[i][length];
+                componentUpper[length] = (c >= 'a' && c <= 'z') ? c - 32 : c;
+            }
+            componentUpper[length] = '\0';
+
+            BufferPrintf(&output,
+"#ifdef %s_XML_OPAQUE\n\
+#error \"UserControl %s is embedded in %s by value, generate it without --opaque-header\"\n\
+#endif\n\
+",
+                componentUpper,
+                includedComponents[i],
+                moduleName
+            );
+        }
+
+        BufferPrintf(&output, "\n");
+
+        free(includedComponents);
+        includedComponents = NULL;
+        includedComponentCount = 0;
+    }
+
+    if (GetBindingPathCount() > 0)
+    {
+        DefineViewModel();
     }
 
-    fprintf(headerFile, "%s", outputBuffer);
-    fclose(headerFile);
+    DefineStruct(fileContents, true);
 
-    printf("    - Wrote header file: %s\n", path);
+    BufferPrintf(&output, "\n#endif /*%s_XML_STRUCT*/\n\n", moduleNameUpper);
+
+    return BufferRelease(&output, size);
 }
 
 
@@ -164,16 +353,129 @@ void %s_Destroy(%s_t* this);\n\
 ** MARK: STATIC FUNCTIONS
 ***************************************************************/
 
+static void SetModuleName(const char* moduleName)
+{
+    sprintf(moduleNameBuffer, "%s", moduleName);
+    
+    for (size_t i = 0; moduleName[i] != '\0'; i++) {
+        moduleNameUpper[i] = (moduleName[i] >= 'a' && moduleName[i] <= 'z') ? moduleName[i] - 32 : moduleName[i];
+    }
+    moduleNameUpper[strlen(moduleName)] = '\0';
+}
+
+static void DefineStruct(TreeNode* rootNode, bool opaque)
+{
+    const char* moduleType = TranslateClassName(rootNode->className);
+
+    if (opaque)
+    {
+        BufferPrintf(&output, "struct %s_s\n", moduleNameBuffer);
+    }
+    else
+    {
+        BufferPrintf(&output, "typedef struct\n");
+    }
+
+    BufferPrintf(&output,
+"{\n\
+    /* Base object */\n\
+    %s super;\n\
+",
+        moduleType
+    );
+
+    if (IsHotColdOrder())
+    {
+        DefineMembers();
+    }
+    else
+    {
+        BufferPrintf(&output, "\n    /* Child views */\n");
+
+        TreeNode* currentNode = rootNode->child;
+
+        while (currentNode != NULL)
+        {
+            DefineObject(currentNode);
+            currentNode = currentNode->sibling;
+        }
+    }
+
+    if (HasDeferred(rootNode))
+    {
+        BufferPrintf(&output, "\n    /* Deferred subtrees, set by their Realize function */\n");
+        DefineDeferred(rootNode, false);
+    }
+
+    if (GetLayoutFrameCount() > 0)
+    {
+        BufferPrintf(&output, "\n    /* Subtrees arranged by nkgen, clear to have NanoKit measure them again */\n");
+
+        for (size_t i = 0; i < GetLayoutFrameCount(); i++)
+        {
+            const LayoutFrame* frame = GetLayoutFrame(i);
+
+            if (frame->sizeOnly)
+            {
+                BufferPrintf(&output, "\tbool %sLayoutValid;\n", frame->node->instanceName);
+            }
+        }
+    }
+
+    if (GetBindingPathCount() > 0)
+    {
+        BufferPrintf(&output, "\n    /* Bound values, see %s_Apply */\n\t%s_ViewModel_t model;\n", moduleNameBuffer, moduleNameBuffer);
+    }
+
+    if (GetThemeCount() > 0)
+    {
+        BufferPrintf(&output, "\n    /* Applied theme, see %s_SetTheme */\n\t%s_Theme_t theme;\n", moduleNameBuffer, moduleNameBuffer);
+    }
+
+    for (size_t i = 0; i < GetListCount(); i++)
+    {
+        const TreeNode* list = GetList(i);
+        const char* name = list->instanceName;
+
+        BufferPrintf(&output,
+"\n\
+    /* Rows of %s, recycled by %s_ScrollTo_%s */\n\
+\t%s_%sRow_t %sRows[%u];\n\
+\tsize_t %sRowItems[%u]; /* item bound to each row, NKGEN_NO_ITEM if none */\n\
+\tsize_t %sItemCount;\n\
+\tsize_t %sFirstItem;\n\
+",
+            name,
+            moduleNameBuffer,
+            name,
+            moduleNameBuffer,
+            name,
+            name,
+            (unsigned)list->items->poolSize,
+            name,
+            (unsigned)list->items->poolSize,
+            name,
+            name
+        );
+    }
+
+    if (opaque)
+    {
+        BufferPrintf(&output, "};\n");
+    }
+    else
+    {
+        BufferPrintf(&output, "} %s_t;\n", moduleNameBuffer);
+    }
+}
+
+
 void DefineObject(TreeNode* node)
 {
     if (!node) return;
 
-    positionInFile += snprintf(outputBuffer + positionInFile, outputBufferSize - positionInFile,
-        "\t%s %s;\n",
-        TranslateClassName(node->className),
-        node->instanceName
-    );
-    
+    DefineMember(node);
+
     TreeNode* childNode = node->child;
     while (childNode != NULL)
     {
@@ -182,6 +484,54 @@ void DefineObject(TreeNode* node)
     }
 }
 
+static void DefineMember(const TreeNode* node)
+{
+    /* a UserControl is embedded as its own module struct, see IncludeComponents */
+    if (node->component)
+    {
+        BufferPrintf(&output, "\t%s_t %s", node->component, node->instanceName);
+    }
+    else
+    {
+        BufferPrintf(&output, "\t%s %s", TranslateClassName(node->className), node->instanceName);
+    }
+
+    if (node->repeatCount)
+    {
+        /* one array per element of a <Repeat>, filled by a loop in _Create */
+        BufferPrintf(&output, "[%u];\n", (unsigned)node->repeatCount);
+    }
+    else
+    {
+        BufferPrintf(&output, ";\n");
+    }
+}
+
+static void DefineMembers(void)
+{
+    /* the root is super, written by DefineStruct */
+    static const char* groupComments[] = {
+        [MEMBER_CONTAINER] = "Containers, walked by every layout pass",
+        [MEMBER_LEAF] = "Leaf views, reached from their containers",
+        [MEMBER_DEFERRED] = "Deferred views, untouched until realized"
+    };
+
+    MemberGroup group = MEMBER_ROOT;
+
+    for (size_t i = 1; i < GetMemberCount(); i++)
+    {
+        const Member* member = GetMember(i);
+
+        if (member->group != group)
+        {
+            group = member->group;
+            BufferPrintf(&output, "\n    /* %s */\n", groupComments[group]);
+        }
+
+        DefineMember(member->node);
+    }
+}
+
 void DefineCallbacks(TreeNode* node)
 {
     if (!node) return;
@@ -191,19 +541,284 @@ void DefineCallbacks(TreeNode* node)
     {
         bool isInherited = false;
         PropertyType type = ResolvePropertyType(node->className, property->key, &isInherited);
-        if (type >= TYPE_GENERIC_CALLBACK)
+        if (type >= TYPE_GENERIC_CALLBACK && !IsBinding(property->value))
         {
-            printf("Defining callback for property '%s' of type '%d'\n", property->key, type);
-            DeclareCallback(type, property->value, outputBuffer, outputBufferSize, &positionInFile);
+            DiagnosticsReportAt(DIAGNOSTIC_DEBUG, node->file, property->line, property->column, "defining callback for property '%s' of type '%d'", property->key, type);
+            DeclareCallback(type, property->value, &output);
         }
 
         property = property->next;
     }
 
+    if (node->items)
+    {
+        BufferPrintf(&output,
+            "void %s(%s_t* module, %s_%sRow_t* row, size_t item);\n",
+            node->items->itemBound,
+            moduleNameBuffer,
+            moduleNameBuffer,
+            node->instanceName
+        );
+
+        DefineCallbacks(node->items->root);
+    }
+
     TreeNode* childNode = node->child;
     while (childNode != NULL)
     {
         DefineCallbacks(childNode);
         childNode = childNode->sibling;
     }
-}
\ No newline at end of file
+}
+
+void DefineDeferred(TreeNode* node, bool declareFunctions)
+{
+    if (!node) return;
+
+    if (node->deferred)
+    {
+        if (declareFunctions)
+        {
+            BufferPrintf(&output,
+                "bool %s_Realize_%s(%s_t* this);\n",
+                moduleNameBuffer,
+                node->instanceName,
+                moduleNameBuffer
+            );
+        }
+        else
+        {
+            BufferPrintf(&output, "\tbool %sRealized;\n", node->instanceName);
+        }
+    }
+
+    TreeNode* childNode = node->child;
+    while (childNode != NULL)
+    {
+        DefineDeferred(childNode, declareFunctions);
+        childNode = childNode->sibling;
+    }
+}
+
+static bool HasDeferred(TreeNode* node)
+{
+    for (; node != NULL; node = node->sibling)
+    {
+        if (node->deferred || HasDeferred(node->child))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void DeclareAccessors(TreeNode* node)
+{
+    /* only elements given a Name in the markup, the generated ones are not part of the interface */
+    for (; node != NULL; node = node->sibling)
+    {
+        if (node->named)
+        {
+            const char* type = node->component ? node->component : TranslateClassName(node->className);
+
+            BufferPrintf(&output,
+                "%s%s* %s_Get_%s(%s_t* this%s);\n",
+                type,
+                node->component ? "_t" : "",
+                moduleNameBuffer,
+                node->instanceName,
+                moduleNameBuffer,
+                node->repeatCount ? ", size_t index" : ""
+            );
+        }
+
+        DeclareAccessors(node->child);
+    }
+}
+
+static void DefineViewModel(void)
+{
+    size_t wordCount = (GetBindingPathCount() + 31) / 32;
+
+    BufferPrintf(&output,
+"/* View model - Written Through the Setters, Pushed to the Views by %s_Apply */\n\
+typedef struct\n\
+{\n\
+",
+        moduleNameBuffer
+    );
+
+    for (size_t i = 0; i < GetBindingPathCount(); i++)
+    {
+        const BindingPath* path = GetBindingPath(i);
+
+        BufferPrintf(&output, "\t%s %s;\n", GetTypeCodeName(path->type), path->name);
+    }
+
+    BufferPrintf(&output,
+"\n\
+\tuint32_t dirty[%zu]; /* one bit per path, set by the setters and cleared by _Apply */\n\
+\tuint32_t valid[%zu]; /* set once the value is known, deferred views adopt it when realized */\n\
+} %s_ViewModel_t;\n\
+\n\
+",
+        wordCount,
+        wordCount,
+        moduleNameBuffer
+    );
+}
+
+static void DeclareSetters(void)
+{
+    BufferPrintf(&output, "\n/* Bindings - Setters Mark Changed Values, _Apply Updates Only Their Views */\n");
+
+    for (size_t i = 0; i < GetBindingPathCount(); i++)
+    {
+        const BindingPath* path = GetBindingPath(i);
+
+        BufferPrintf(&output,
+            "void %s_Set%s(%s_t* this, %s value);\n",
+            moduleNameBuffer,
+            path->name,
+            moduleNameBuffer,
+            GetTypeCodeName(path->type)
+        );
+    }
+
+    BufferPrintf(&output, "bool %s_Apply(%s_t* this);\n", moduleNameBuffer, moduleNameBuffer);
+}
+
+static void DefineThemes(void)
+{
+    BufferPrintf(&output,
+"/* Themes - In Declaration Order */\n\
+typedef enum\n\
+{\n\
+"
+    );
+
+    for (size_t i = 0; i < GetThemeCount(); i++)
+    {
+        BufferPrintf(&output, "\t%s_Theme_%s,\n", moduleNameBuffer, GetTheme(i)->instanceName);
+    }
+
+    BufferPrintf(&output,
+"\t%s_ThemeCount\n\
+} %s_Theme_t;\n\
+\n\
+",
+        moduleNameBuffer,
+        moduleNameBuffer
+    );
+}
+
+static void DefineRows(void)
+{
+    for (size_t i = 0; i < GetListCount(); i++)
+    {
+        const TreeNode* list = GetList(i);
+
+        BufferPrintf(&output,
+"/* Row of %s - One per Pool Slot, Filled by %s */\n\
+typedef struct\n\
+{\n\
+",
+            list->instanceName,
+            list->items->itemBound
+        );
+
+        DefineObject(list->items->root);
+
+        BufferPrintf(&output, "} %s_%sRow_t;\n\n", moduleNameBuffer, list->instanceName);
+    }
+}
+
+static void DefineViewIds(void)
+{
+    BufferPrintf(&output,
+"/* View IDs - Every Member View in Declaration Order */\n\
+typedef enum %s_ViewId\n\
+{\n\
+",
+        moduleNameBuffer
+    );
+
+    for (size_t i = 0; i < GetViewIdCount(); i++)
+    {
+        BufferPrintf(&output, "\t%s_View_%s,\n", moduleNameBuffer, GetViewIdNode(i)->instanceName);
+    }
+
+    BufferPrintf(&output,
+"\t%s_ViewCount\n\
+} %s_ViewId_t;\n\
+\n\
+",
+        moduleNameBuffer,
+        moduleNameBuffer
+    );
+}
+
+static void DefineEvents(void)
+{
+    BufferPrintf(&output,
+"/* Events - Every Routed Callback Attribute */\n\
+typedef enum %s_Event\n\
+{\n\
+",
+        moduleNameBuffer
+    );
+
+    for (size_t i = 0; i < GetEventCount(); i++)
+    {
+        BufferPrintf(&output, "\t%s_Event_%s,\n", moduleNameBuffer, GetEventName(i));
+    }
+
+    BufferPrintf(&output,
+"\t%s_EventCount\n\
+} %s_Event_t;\n\
+\n\
+",
+        moduleNameBuffer,
+        moduleNameBuffer
+    );
+}
+
+static void IncludeComponents(const TreeNode* node, bool namedOnly)
+{
+    /* only the component headers are needed, editing a component regenerates its own module alone */
+    for (; node != NULL; node = node->sibling)
+    {
+        if (node->component && (node->named || !namedOnly))
+        {
+            bool included = false;
+
+            for (size_t i = 0; i < includedComponentCount && !included; i++)
+            {
+                included = strcmp(includedComponents[i], node->component) == 0;
+            }
+
+            if (!included)
+            {
+                const char** grown = (const char**)realloc(includedComponents, (includedComponentCount + 1) * sizeof(const char*));
+
+                if (!grown) return;
+
+                includedComponents = grown;
+                includedComponents[includedComponentCount++] = node->component;
+
+                BufferPrintf(&output, "#include \"%s.xml.h\"\n", node->component);
+            }
+        }
+
+        if (node->items && node->items->root)
+        {
+            IncludeComponents(node->items->root, false); /* rows are declared in full either way */
+        }
+
+        if (node->child)
+        {
+            IncludeComponents(node->child, namedOnly);
+        }
+    }
+}
@@ -34,6 +34,12 @@
 ** MARK: FUNCTION DEFS
 ***************************************************************/
 
-void WriteHeaderFile(const char* path, const char* moduleName, TreeNode* fileContents);
+/* Returns the generated file contents, the caller must free them,
+   an opaque header only forward declares the module struct and hands out its named views through accessors,
+   footprint declares _GetFootprint */
+char* GenerateHeaderFile(const char* path, const char* moduleName, TreeNode* fileContents, bool opaque, bool footprint, size_t* size);
+
+/* The module struct definition of an opaque header, written at the top of the module source and its chunks */
+char* GenerateModuleStruct(const char* moduleName, TreeNode* fileContents, size_t* size);
 
 #endif /* HEADER_H */
\ No newline at end of file
@@ -0,0 +1,173 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  items.c
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen virtualized ListView and ItemsControl collection
+**
+***************************************************************/
+
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stats/alloc.h>
+
+#include <binding/binding.h>
+#include <theme/theme.h>
+#include <diagnostics/diagnostics.h>
+
+#include "items.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static const TreeNode** lists = NULL;
+static size_t listCount = 0;
+static size_t listCapacity = 0;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static bool CollectNode(TreeNode* node);
+static bool ValidateTemplate(const TreeNode* node, const TreeNode* list);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool CollectLists(TreeNode* rootNode)
+{
+    ClearLists();
+
+    if (!rootNode) return true;
+
+    return CollectNode(rootNode);
+}
+
+void ClearLists(void)
+{
+    free(lists);
+
+    lists = NULL;
+    listCount = 0;
+    listCapacity = 0;
+}
+
+size_t GetListCount(void)
+{
+    return listCount;
+}
+
+const TreeNode* GetList(size_t index)
+{
+    return (index < listCount) ? lists[index] : NULL;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static bool CollectNode(TreeNode* node)
+{
+    bool valid = true;
+
+    /* siblings are walked in a loop, only depth recurses */
+    for (; node != NULL; node = node->sibling)
+    {
+        if (node->items && node->items->root)
+        {
+            if (!ValidateTemplate(node->items->root, node))
+            {
+                valid = false;
+            }
+
+            /* the callback is declared with this list's row type */
+            for (size_t i = 0; i < listCount; i++)
+            {
+                if (strcmp(lists[i]->items->itemBound, node->items->itemBound) == 0)
+                {
+                    DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, node->line, node->column, "ItemBound '%s' already fills the rows of '%s' at %u:%u", node->items->itemBound, lists[i]->instanceName, (unsigned)lists[i]->line, (unsigned)lists[i]->column);
+                    valid = false;
+                    break;
+                }
+            }
+
+            if (listCount == listCapacity)
+            {
+                size_t capacity = listCapacity ? listCapacity * 2 : 8;
+                const TreeNode** grown = (const TreeNode**)realloc(lists, capacity * sizeof(const TreeNode*));
+
+                if (!grown) return false;
+
+                lists = grown;
+                listCapacity = capacity;
+            }
+
+            lists[listCount++] = node;
+        }
+
+        if (node->child && !CollectNode(node->child))
+        {
+            valid = false;
+        }
+    }
+
+    return valid;
+}
+
+static bool ValidateTemplate(const TreeNode* node, const TreeNode* list)
+{
+    bool valid = true;
+
+    /* rows are plain structs rebuilt per pool slot, per node machinery has nowhere to live in them */
+    for (; node != NULL; node = node->sibling)
+    {
+        if (node->deferred)
+        {
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, node->line, node->column, "'%s' cannot be deferred inside the ItemTemplate of '%s'", node->instanceName, list->instanceName);
+            valid = false;
+        }
+
+        if (node->items)
+        {
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, node->line, node->column, "%s cannot be nested inside the ItemTemplate of '%s'", node->className, list->instanceName);
+            valid = false;
+        }
+
+        for (const NodeProperty* property = node->properties; property != NULL; property = property->next)
+        {
+            if (IsBinding(property->value) || IsThemeResource(property->value))
+            {
+                DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, property->line, property->column, "'%s' cannot be used inside an ItemTemplate, rows are filled by %s", property->value, list->items->itemBound);
+                valid = false;
+            }
+        }
+
+        if (node->child && !ValidateTemplate(node->child, list))
+        {
+            valid = false;
+        }
+    }
+
+    return valid;
+}
@@ -0,0 +1,46 @@
+/***************************************************************
+**
+** NanoKit Tool Header File
+**
+** File         :  items.h
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen virtualized ListView and ItemsControl collection
+**
+***************************************************************/
+
+#ifndef ITEMS_H
+#define ITEMS_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <parser/parser.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* Gathers the lists of a validated tree in document order, reports templates that use what rows cannot */
+bool CollectLists(TreeNode* rootNode);
+void ClearLists(void);
+
+size_t GetListCount(void);
+const TreeNode* GetList(size_t index);
+
+#endif /* ITEMS_H */
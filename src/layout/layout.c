@@ -0,0 +1,350 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  layout.c
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen generation time layout of fixed size subtrees
+**
+***************************************************************/
+
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stats/alloc.h>
+
+#include <binding/binding.h>
+
+#include "layout.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef enum
+{
+    ALIGN_START,
+    ALIGN_CENTER,
+    ALIGN_END
+} Alignment;
+
+/* Everything the arrange pass needs from one node's attributes */
+typedef struct
+{
+    float width;
+    float height;
+    float margin[4];    /* left, top, right, bottom */
+    Alignment horizontal;
+    Alignment vertical;
+    bool horizontalStack;
+} FixedNode;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static LayoutFrame* frames = NULL;
+static size_t frameCount = 0;
+static size_t frameCapacity = 0;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static bool Visit(const TreeNode* node);
+static bool ReadFixedNode(const TreeNode* node, FixedNode* fixed);
+static void Arrange(const TreeNode* node, float x, float y, bool sizeOnly);
+static void AddFrame(const TreeNode* node, float x, float y, float width, float height, bool sizeOnly);
+
+static const char* FindValue(const TreeNode* node, const char* key);
+static bool ParseNumber(const char* value, float* number);
+static bool ParseMargin(const char* value, float margin[4]);
+static bool ParseAlignment(const char* value, bool horizontal, Alignment* alignment);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void PrecomputeLayout(const TreeNode* rootNode)
+{
+    ClearLayout();
+
+    if (rootNode && Visit(rootNode) && rootNode->child)
+    {
+        Arrange(rootNode, 0.0f, 0.0f, true);
+    }
+}
+
+void ClearLayout(void)
+{
+    free(frames);
+
+    frames = NULL;
+    frameCount = 0;
+    frameCapacity = 0;
+}
+
+size_t GetLayoutFrameCount(void)
+{
+    return frameCount;
+}
+
+const LayoutFrame* GetLayoutFrame(size_t index)
+{
+    return (index < frameCount) ? &frames[index] : NULL;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static bool Visit(const TreeNode* node)
+{
+    /* a node is fixed when its own size is constant and it arranges only fixed children,
+       the largest fixed subtrees below a node laid out at runtime are arranged here */
+    /* deferred subtrees are not built by _Create, they are laid out at runtime once realized,
+       repeated elements are member arrays that share one node, and a UserControl's content is
+       generated from another file, so they are left to NanoKit too */
+    if (node->deferred || node->repeatCount || node->component) return false;
+
+    FixedNode fixed;
+    bool isFixed = ReadFixedNode(node, &fixed);
+
+    size_t childCount = 0;
+    for (const TreeNode* child = node->child; child != NULL; child = child->sibling) childCount++;
+
+    if (childCount > 0 && strcmp(node->className, "StackPanel") != 0)
+    {
+        /* only stacking is modelled, other panels measure their children at runtime */
+        isFixed = false;
+    }
+
+    bool* childFixed = childCount ? (bool*)malloc(childCount * sizeof(bool)) : NULL;
+
+    if (childCount && !childFixed) return false;
+
+    size_t index = 0;
+    for (const TreeNode* child = node->child; child != NULL; child = child->sibling, index++)
+    {
+        childFixed[index] = Visit(child);
+
+        if (!childFixed[index])
+        {
+            isFixed = false;
+        }
+    }
+
+    if (!isFixed)
+    {
+        index = 0;
+        for (const TreeNode* child = node->child; child != NULL; child = child->sibling, index++)
+        {
+            if (childFixed[index] && child->child)
+            {
+                Arrange(child, 0.0f, 0.0f, true);
+            }
+        }
+    }
+
+    free(childFixed);
+
+    return isFixed;
+}
+
+static bool ReadFixedNode(const TreeNode* node, FixedNode* fixed)
+{
+    memset(fixed, 0, sizeof(FixedNode));
+
+    if (strcmp(node->className, "Window") == 0) return false;
+
+    /* explicit size on every view, anything bound or unparsable is left to the runtime */
+    if (!ParseNumber(FindValue(node, "Width"), &fixed->width)) return false;
+    if (!ParseNumber(FindValue(node, "Height"), &fixed->height)) return false;
+
+    const char* margin = FindValue(node, "Margin");
+    if (margin && !ParseMargin(margin, fixed->margin)) return false;
+
+    if (!ParseAlignment(FindValue(node, "HorizontalAlignment"), true, &fixed->horizontal)) return false;
+    if (!ParseAlignment(FindValue(node, "VerticalAlignment"), false, &fixed->vertical)) return false;
+
+    const char* orientation = FindValue(node, "Orientation");
+
+    if (orientation && IsBinding(orientation)) return false;
+
+    fixed->horizontalStack = orientation && strcmp(orientation, "Horizontal") == 0;
+
+    return true;
+}
+
+static void Arrange(const TreeNode* node, float x, float y, bool sizeOnly)
+{
+    FixedNode fixed;
+    ReadFixedNode(node, &fixed);
+
+    AddFrame(node, x, y, fixed.width, fixed.height, sizeOnly);
+
+    /* stack children along the orientation, each slot spans the panel across it */
+    float cursor = 0.0f;
+
+    for (const TreeNode* child = node->child; child != NULL; child = child->sibling)
+    {
+        FixedNode item;
+        ReadFixedNode(child, &item);
+
+        const float* margin = item.margin;
+        float childX;
+        float childY;
+
+        if (fixed.horizontalStack)
+        {
+            childX = cursor + margin[0];
+            cursor += margin[0] + item.width + margin[2];
+
+            float space = fixed.height - margin[1] - margin[3] - item.height;
+            childY = margin[1] + ((item.vertical == ALIGN_CENTER) ? space / 2.0f : (item.vertical == ALIGN_END) ? space : 0.0f);
+        }
+        else
+        {
+            childY = cursor + margin[1];
+            cursor += margin[1] + item.height + margin[3];
+
+            float space = fixed.width - margin[0] - margin[2] - item.width;
+            childX = margin[0] + ((item.horizontal == ALIGN_CENTER) ? space / 2.0f : (item.horizontal == ALIGN_END) ? space : 0.0f);
+        }
+
+        Arrange(child, childX, childY, false);
+    }
+}
+
+static void AddFrame(const TreeNode* node, float x, float y, float width, float height, bool sizeOnly)
+{
+    if (frameCount == frameCapacity)
+    {
+        size_t capacity = frameCapacity ? frameCapacity * 2 : 64;
+        LayoutFrame* grown = (LayoutFrame*)realloc(frames, capacity * sizeof(LayoutFrame));
+
+        if (!grown) return;
+
+        frames = grown;
+        frameCapacity = capacity;
+    }
+
+    frames[frameCount].node = node;
+    frames[frameCount].x = x;
+    frames[frameCount].y = y;
+    frames[frameCount].width = width;
+    frames[frameCount].height = height;
+    frames[frameCount].sizeOnly = sizeOnly;
+    frameCount++;
+}
+
+static const char* FindValue(const TreeNode* node, const char* key)
+{
+    /* the last attribute wins, as it does in the generated stores */
+    const char* value = NULL;
+
+    for (const NodeProperty* property = node->properties; property != NULL; property = property->next)
+    {
+        if (strcmp(property->key, key) == 0)
+        {
+            value = property->value;
+        }
+    }
+
+    return value;
+}
+
+static bool ParseNumber(const char* value, float* number)
+{
+    if (!value || IsBinding(value)) return false;
+
+    char* end = NULL;
+    *number = strtof(value, &end);
+
+    while (end && (*end == ' ' || *end == '\t')) end++;
+
+    return end != value && end && *end == '\0' && *number >= 0.0f;
+}
+
+static bool ParseMargin(const char* value, float margin[4])
+{
+    /* "uniform", "horizontal,vertical" or "left,top,right,bottom" */
+    if (IsBinding(value)) return false;
+
+    float parts[4];
+    size_t count = 0;
+    const char* cursor = value;
+
+    for (;;)
+    {
+        char* end = NULL;
+
+        if (count == 4) return false;
+
+        parts[count++] = strtof(cursor, &end);
+
+        if (end == cursor) return false;
+
+        while (*end == ' ' || *end == '\t') end++;
+
+        if (*end == '\0') break;
+        if (*end != ',') return false;
+
+        cursor = end + 1;
+    }
+
+    if (count == 1)
+    {
+        margin[0] = margin[1] = margin[2] = margin[3] = parts[0];
+    }
+    else if (count == 2)
+    {
+        margin[0] = margin[2] = parts[0];
+        margin[1] = margin[3] = parts[1];
+    }
+    else if (count == 4)
+    {
+        memcpy(margin, parts, sizeof(parts));
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+static bool ParseAlignment(const char* value, bool horizontal, Alignment* alignment)
+{
+    /* an explicitly sized view keeps its size under Stretch and is centred in its slot */
+    *alignment = ALIGN_CENTER;
+
+    if (!value || strcmp(value, "Stretch") == 0 || strcmp(value, "Center") == 0) return true;
+
+    if (strcmp(value, horizontal ? "Left" : "Top") == 0)
+    {
+        *alignment = ALIGN_START;
+        return true;
+    }
+
+    if (strcmp(value, horizontal ? "Right" : "Bottom") == 0)
+    {
+        *alignment = ALIGN_END;
+        return true;
+    }
+
+    return false;
+}
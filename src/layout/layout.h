@@ -0,0 +1,57 @@
+/***************************************************************
+**
+** NanoKit Tool Header File
+**
+** File         :  layout.h
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen generation time layout of fixed size subtrees
+**
+***************************************************************/
+
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <parser/parser.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* Arranged rectangle of one view, relative to its parent */
+typedef struct
+{
+    const TreeNode* node;
+    float x;
+    float y;
+    float width;
+    float height;
+    bool sizeOnly;      /* subtree root, its position is still chosen by a parent laid out at runtime */
+} LayoutFrame;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* Finds the largest subtrees fixed by constants and arranges them, frames come out in pre-order */
+void PrecomputeLayout(const TreeNode* rootNode);
+void ClearLayout(void);
+
+size_t GetLayoutFrameCount(void);
+const LayoutFrame* GetLayoutFrame(size_t index);
+
+#endif /* LAYOUT_H */
@@ -0,0 +1,383 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  lookup.c
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen view IDs and the perfect hash behind _FindByName
+**
+***************************************************************/
+
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stats/alloc.h>
+
+#include <diagnostics/diagnostics.h>
+#include <members/members.h>
+
+#include "lookup.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define LOOKUP_BUCKET_SIZE 4            /* names per displacement on average, keeps the table small and the search short */
+#define LOOKUP_MAX_DISPLACEMENT 65535   /* a bucket that fits nowhere below this starts over with the next seed */
+#define LOOKUP_MAX_SEEDS 16
+
+#define LOOKUP_FREE SIZE_MAX
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static const TreeNode** views = NULL;
+static size_t viewCount = 0;
+static size_t viewCapacity = 0;
+
+static uint32_t hashSeed = 0;
+static size_t bucketCount = 0;
+static uint32_t* displacements = NULL;
+static size_t* slotIds = NULL;
+
+/* scratch for BuildHash, bucket members are contiguous in bucketMembers */
+static uint32_t* hashes = NULL;
+static size_t* bucketStarts = NULL;
+static size_t* bucketMembers = NULL;
+static size_t* bucketOrder = NULL;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static bool AddViews(const TreeNode* node);
+static bool AddView(const TreeNode* node);
+static bool BuildHash(void);
+static bool TrySeed(uint32_t seed);
+static bool PlaceBucket(size_t bucket);
+static bool ReportDuplicates(size_t bucket);
+
+static uint32_t NameHash(uint32_t seed, const char* name);
+static size_t SlotOf(uint32_t hash, uint32_t displacement);
+
+static int CompareBuckets(const void* a, const void* b);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool CollectViewIds(const TreeNode* rootNode)
+{
+    ClearViewIds();
+
+    if (!rootNode) return true;
+
+    /* the same order as the struct members, the root first */
+    if (GetMemberCount() > 0)
+    {
+        for (size_t i = 0; i < GetMemberCount(); i++)
+        {
+            if (!AddView(GetMember(i)->node)) return false;
+        }
+    }
+    else if (!AddViews(rootNode))
+    {
+        return false;
+    }
+
+    return BuildHash();
+}
+
+void ClearViewIds(void)
+{
+    free(views);
+    free(displacements);
+    free(slotIds);
+
+    views = NULL;
+    viewCount = 0;
+    viewCapacity = 0;
+    hashSeed = 0;
+    bucketCount = 0;
+    displacements = NULL;
+    slotIds = NULL;
+}
+
+size_t GetViewIdCount(void)
+{
+    return viewCount;
+}
+
+const TreeNode* GetViewIdNode(size_t id)
+{
+    return (id < viewCount) ? views[id] : NULL;
+}
+
+uint32_t GetViewHashSeed(void)
+{
+    return hashSeed;
+}
+
+size_t GetViewBucketCount(void)
+{
+    return bucketCount;
+}
+
+uint32_t GetViewDisplacement(size_t bucket)
+{
+    return (bucket < bucketCount) ? displacements[bucket] : 0;
+}
+
+size_t GetViewSlotId(size_t slot)
+{
+    return (slot < viewCount) ? slotIds[slot] : 0;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static bool AddViews(const TreeNode* node)
+{
+    if (!AddView(node)) return false;
+
+    for (const TreeNode* child = node->child; child != NULL; child = child->sibling)
+    {
+        if (!AddViews(child)) return false;
+    }
+
+    return true;
+}
+
+static bool AddView(const TreeNode* node)
+{
+    if (viewCount == viewCapacity)
+    {
+        size_t capacity = viewCapacity ? viewCapacity * 2 : 64;
+        const TreeNode** grown = (const TreeNode**)realloc(views, capacity * sizeof(const TreeNode*));
+
+        if (!grown) return false;
+
+        views = grown;
+        viewCapacity = capacity;
+    }
+
+    /* a repeated view is one member array, its ID stands for the first element */
+    views[viewCount++] = node;
+
+    return true;
+}
+
+static bool BuildHash(void)
+{
+    bucketCount = viewCount / LOOKUP_BUCKET_SIZE + 1;
+
+    displacements = (uint32_t*)calloc(bucketCount, sizeof(uint32_t));
+    slotIds = (size_t*)malloc(viewCount * sizeof(size_t));
+    hashes = (uint32_t*)malloc(viewCount * sizeof(uint32_t));
+    bucketStarts = (size_t*)malloc((bucketCount + 1) * sizeof(size_t));
+    bucketMembers = (size_t*)malloc(viewCount * sizeof(size_t));
+    bucketOrder = (size_t*)malloc(bucketCount * sizeof(size_t));
+
+    bool built = displacements && slotIds && hashes && bucketStarts && bucketMembers && bucketOrder;
+
+    if (built)
+    {
+        built = false;
+
+        /* a seed only fails when a displacement runs out, which is rare enough to simply try the next */
+        for (uint32_t attempt = 0; attempt < LOOKUP_MAX_SEEDS && !built; attempt++)
+        {
+            hashSeed = 2166136261u + attempt * 0x9E3779B9u;
+            built = TrySeed(hashSeed);
+
+            /* the same name always collides, another seed would not help */
+            for (size_t i = 0; i < bucketCount && !built; i++)
+            {
+                if (ReportDuplicates(i))
+                {
+                    attempt = LOOKUP_MAX_SEEDS;
+                    break;
+                }
+            }
+        }
+    }
+
+    free(hashes);
+    free(bucketStarts);
+    free(bucketMembers);
+    free(bucketOrder);
+
+    hashes = NULL;
+    bucketStarts = NULL;
+    bucketMembers = NULL;
+    bucketOrder = NULL;
+
+    if (!built)
+    {
+        ClearViewIds();
+    }
+
+    return built;
+}
+
+static bool TrySeed(uint32_t seed)
+{
+    /* counting sort of the names by bucket */
+    memset(bucketStarts, 0, (bucketCount + 1) * sizeof(size_t));
+
+    for (size_t i = 0; i < viewCount; i++)
+    {
+        hashes[i] = NameHash(seed, views[i]->instanceName);
+        bucketStarts[hashes[i] % bucketCount + 1]++;
+    }
+
+    for (size_t i = 0; i < bucketCount; i++)
+    {
+        bucketStarts[i + 1] += bucketStarts[i];
+        bucketOrder[i] = i;
+    }
+
+    for (size_t i = 0; i < viewCount; i++)
+    {
+        slotIds[i] = bucketStarts[hashes[i] % bucketCount]++;
+    }
+
+    for (size_t i = 0; i < viewCount; i++)
+    {
+        bucketMembers[slotIds[i]] = i;
+    }
+
+    for (size_t i = bucketCount; i > 0; i--)
+    {
+        bucketStarts[i] = bucketStarts[i - 1];
+    }
+
+    bucketStarts[0] = 0;
+
+    /* the fullest buckets go first, while most slots are still free */
+    qsort(bucketOrder, bucketCount, sizeof(size_t), CompareBuckets);
+
+    for (size_t i = 0; i < viewCount; i++)
+    {
+        slotIds[i] = LOOKUP_FREE;
+    }
+
+    for (size_t i = 0; i < bucketCount; i++)
+    {
+        if (!PlaceBucket(bucketOrder[i])) return false;
+    }
+
+    return true;
+}
+
+static bool PlaceBucket(size_t bucket)
+{
+    size_t first = bucketStarts[bucket];
+    size_t last = bucketStarts[bucket + 1];
+
+    if (first == last) return true;
+
+    for (uint32_t displacement = 0; displacement <= LOOKUP_MAX_DISPLACEMENT; displacement++)
+    {
+        size_t placed = first;
+
+        for (; placed < last; placed++)
+        {
+            size_t slot = SlotOf(hashes[bucketMembers[placed]], displacement);
+
+            if (slotIds[slot] != LOOKUP_FREE) break;
+
+            slotIds[slot] = bucketMembers[placed];
+        }
+
+        if (placed == last)
+        {
+            displacements[bucket] = displacement;
+            return true;
+        }
+
+        /* a member landed on a taken slot, free the ones placed before it */
+        while (placed > first)
+        {
+            placed--;
+            slotIds[SlotOf(hashes[bucketMembers[placed]], displacement)] = LOOKUP_FREE;
+        }
+    }
+
+    return false;
+}
+
+static bool ReportDuplicates(size_t bucket)
+{
+    bool duplicate = false;
+
+    for (size_t i = bucketStarts[bucket]; i < bucketStarts[bucket + 1]; i++)
+    {
+        for (size_t j = bucketStarts[bucket]; j < i; j++)
+        {
+            const TreeNode* node = views[bucketMembers[i]];
+            const TreeNode* other = views[bucketMembers[j]];
+
+            if (strcmp(node->instanceName, other->instanceName) == 0)
+            {
+                DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, node->line, node->column, "Name '%s' is already used at %u:%u", node->instanceName, (unsigned)other->line, (unsigned)other->column);
+                duplicate = true;
+            }
+        }
+    }
+
+    return duplicate;
+}
+
+static uint32_t NameHash(uint32_t seed, const char* name)
+{
+    /* mirrors the generated _FindByName */
+    uint32_t hash = seed;
+
+    for (; *name != '\0'; name++)
+    {
+        hash ^= (uint8_t)*name;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static size_t SlotOf(uint32_t hash, uint32_t displacement)
+{
+    /* mirrors the generated _FindByName */
+    uint32_t mixed = hash + displacement * 0x9E3779B9u;
+    mixed ^= mixed >> 16;
+    mixed *= 0x85EBCA6Bu;
+    mixed ^= mixed >> 13;
+
+    return mixed % viewCount;
+}
+
+static int CompareBuckets(const void* a, const void* b)
+{
+    size_t bucketA = *(const size_t*)a;
+    size_t bucketB = *(const size_t*)b;
+
+    size_t sizeA = bucketStarts[bucketA + 1] - bucketStarts[bucketA];
+    size_t sizeB = bucketStarts[bucketB + 1] - bucketStarts[bucketB];
+
+    if (sizeA != sizeB) return (sizeA > sizeB) ? -1 : 1;
+
+    return (bucketA < bucketB) ? -1 : (bucketA > bucketB) ? 1 : 0;
+}
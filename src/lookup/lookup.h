@@ -0,0 +1,55 @@
+/***************************************************************
+**
+** NanoKit Tool Header File
+**
+** File         :  lookup.h
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen view IDs and the perfect hash behind _FindByName
+**
+***************************************************************/
+
+#ifndef LOOKUP_H
+#define LOOKUP_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <parser/parser.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* Numbers every member view of the module in declaration order and places the names in a minimal perfect hash,
+   reports names used by more than one element */
+bool CollectViewIds(const TreeNode* rootNode);
+void ClearViewIds(void);
+
+/* 0 unless view IDs were collected */
+size_t GetViewIdCount(void);
+const TreeNode* GetViewIdNode(size_t id);
+
+/* The hash written into _FindByName, a name's bucket is its hash modulo the bucket count
+   and its slot follows from the bucket's displacement */
+uint32_t GetViewHashSeed(void);
+size_t GetViewBucketCount(void);
+uint32_t GetViewDisplacement(size_t bucket);
+size_t GetViewSlotId(size_t slot);
+
+#endif /* LOOKUP_H */
@@ -18,11 +18,11 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdarg.h>
 
-#include <parser/parser.h>
-#include <header/header.h>
-#include <source/source.h>
-#include <translator/translator.h>
+#include <nkgen/nkgen.h>
 
 /***************************************************************
 ** MARK: CONSTANTS & MACROS
@@ -40,6 +40,20 @@
 ***************************************************************/
 
 int LoadFile(const char* path, char** buffer, size_t* size);
+int WriteOutputFile(const char* path, const char* contents, size_t size);
+int WriteDepFile(const char* path, const char* target, const char* inputFile, const NkGenOutput* output);
+int WriteManifest(const char* path, const char* outputSource, const NkGenOutput* output);
+int WriteStampFile(const char* path, const char* moduleName);
+int WriteUnityFile(const char* path, char* const* sources, int sourceCount);
+static void WriteDepFilePath(FILE* file, const char* path);
+static bool SameFileContents(const char* path, const char* contents, size_t size);
+
+static void PrintDiagnostics(const NkGenOutput* output);
+static void Note(NkGenDiagnosticLevel level, NkGenDiagnosticLevel maximumLevel, const char* format, ...);
+
+static void PrintStats(const char* moduleName, const NkGenOutput* output);
+static int AppendStatsJson(const char* path, const char* moduleName, const char* inputFile, const NkGenOutput* output);
+static void WriteJsonString(FILE* file, const char* string);
 
 /***************************************************************
 ** MARK: PUBLIC FUNCTIONS
@@ -48,45 +62,333 @@ int LoadFile(const char* path, char** buffer, size_t* size);
 int main(int argc, char *argv[]) 
 {
 
-    if (argc != 5) {
-        fprintf(stderr, "Usage: %s <moduleName> <input.xml> <output.h> <output.c>\n", argv[0]);
+    /* one translation unit including every generated source, so the NanoKit headers are parsed once per build */
+    if (argc >= 2 && strcmp(argv[1], "--unity") == 0)
+    {
+        if (argc < 4)
+        {
+            fprintf(stderr, "Usage: %s --unity <output.c> <source.c>...\n", argv[0]);
+            return 1;
+        }
+
+        if (WriteUnityFile(argv[2], argv + 3, argc - 3))
+        {
+            fprintf(stderr, "%s: error: could not write unity source\n", argv[2]);
+            return 1;
+        }
+
+        return 0;
+    }
+
+    char *positional[4];
+    int positionalCount = 0;
+
+    char *depFile = NULL;
+    char *stampFile = NULL;
+    char *treeDumpFile = NULL;
+    char *footprintFile = NULL;
+
+    NkGenBackend backend = NKGEN_BACKEND_UNROLLED;
+    bool staticLinks = false;
+    bool precomputeLayout = false;
+    bool poolConstants = false;
+    bool inlineSubtrees = false;
+    uint32_t sourceChunks = 0;
+    bool opaqueHeader = false;
+    bool viewIds = false;
+    bool routeEvents = false;
+    bool hotColdMembers = false;
+
+    /* warnings and errors go to stderr, stdout stays empty unless asked for */
+    NkGenDiagnosticLevel diagnosticLevel = NKGEN_DIAGNOSTIC_WARNING;
+
+    /* per module statistics, also enabled through NKGEN_STATS and NKGEN_STATS_JSON */
+    const char *statsEnvironment = getenv("NKGEN_STATS");
+    bool printStats = statsEnvironment && statsEnvironment[0] != '\0' && strcmp(statsEnvironment, "0") != 0;
+    const char *statsJson = getenv("NKGEN_STATS_JSON");
+
+    if (statsJson && statsJson[0] == '\0')
+    {
+        statsJson = NULL;
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--depfile") == 0 && i + 1 < argc)
+        {
+            depFile = argv[++i];
+        }
+        else if (strcmp(argv[i], "--stamp") == 0 && i + 1 < argc)
+        {
+            stampFile = argv[++i];
+        }
+        else if (strcmp(argv[i], "--backend") == 0 && i + 1 < argc)
+        {
+            if (!nkgen_backend_from_name(argv[++i], &backend))
+            {
+                fprintf(stderr, "nkgen: error: unknown backend '%s', expected unrolled, table or prototype\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--static-links") == 0)
+        {
+            staticLinks = true;
+        }
+        else if (strcmp(argv[i], "--precompute-layout") == 0)
+        {
+            precomputeLayout = true;
+        }
+        else if (strcmp(argv[i], "--pool-constants") == 0)
+        {
+            poolConstants = true;
+        }
+        else if (strcmp(argv[i], "--inline-subtrees") == 0)
+        {
+            inlineSubtrees = true;
+        }
+        else if (strcmp(argv[i], "--split") == 0 && i + 1 < argc)
+        {
+            char *end = NULL;
+            unsigned long count = strtoul(argv[++i], &end, 10);
+
+            if (end == argv[i] || *end != '\0' || count < 1 || count > NKGEN_MAX_SOURCE_CHUNKS)
+            {
+                fprintf(stderr, "nkgen: error: invalid chunk count '%s', expected 1 to %d\n", argv[i], NKGEN_MAX_SOURCE_CHUNKS);
+                return 1;
+            }
+
+            sourceChunks = (uint32_t)count;
+        }
+        else if (strcmp(argv[i], "--opaque-header") == 0)
+        {
+            opaqueHeader = true;
+        }
+        else if (strcmp(argv[i], "--view-ids") == 0)
+        {
+            viewIds = true;
+        }
+        else if (strcmp(argv[i], "--route-events") == 0)
+        {
+            routeEvents = true;
+        }
+        else if (strcmp(argv[i], "--hot-cold-members") == 0)
+        {
+            hotColdMembers = true;
+        }
+        else if (strcmp(argv[i], "--footprint") == 0 && i + 1 < argc)
+        {
+            footprintFile = argv[++i];
+        }
+        else if (strcmp(argv[i], "--dump-tree") == 0 && i + 1 < argc)
+        {
+            treeDumpFile = argv[++i];
+        }
+        else if (strcmp(argv[i], "--quiet") == 0)
+        {
+            diagnosticLevel = NKGEN_DIAGNOSTIC_ERROR;
+        }
+        else if (strcmp(argv[i], "--verbose") == 0)
+        {
+            diagnosticLevel = NKGEN_DIAGNOSTIC_INFO;
+        }
+        else if (strcmp(argv[i], "--debug") == 0)
+        {
+            diagnosticLevel = NKGEN_DIAGNOSTIC_DEBUG;
+        }
+        else if (strcmp(argv[i], "--stats") == 0)
+        {
+            printStats = true;
+        }
+        else if (strcmp(argv[i], "--stats-json") == 0 && i + 1 < argc)
+        {
+            statsJson = argv[++i];
+        }
+        else if (strncmp(argv[i], "--", 2) != 0 && positionalCount < 4)
+        {
+            positional[positionalCount++] = argv[i];
+        }
+        else
+        {
+            positionalCount = -1;
+            break;
+        }
+    }
+
+    if (positionalCount != 4) {
+        fprintf(stderr, "Usage: %s [--quiet | --verbose | --debug] [--backend unrolled|table|prototype] [--static-links] [--precompute-layout] [--pool-constants] [--inline-subtrees] [--split <chunks>] [--opaque-header] [--view-ids] [--route-events] [--hot-cold-members] [--footprint <manifest.txt>] [--dump-tree <tree.txt>] [--depfile <output.d>] [--stamp <output.stamp>] [--stats] [--stats-json <stats.jsonl>] <moduleName> <input.xml> <output.h> <output.c>\n       %s --unity <output.c> <source.c>...\n", argv[0], argv[0]);
         return 1;
     }
 
-    char *moduleName = argv[1];
-    char *inputFile = argv[2];
-    char *outputHeader = argv[3];
-    char *outputSource = argv[4];
+    char *moduleName = positional[0];
+    char *inputFile = positional[1];
+    char *outputHeader = positional[2];
+    char *outputSource = positional[3];
 
     size_t inputFileSize;
     char *inputFileBuffer;
 
+    double phaseStart = nkgen_time_seconds();
+
     if (LoadFile(inputFile, &inputFileBuffer, &inputFileSize)) 
     {
-        fprintf(stderr, "Error: Could not load input file\n");
+        fprintf(stderr, "%s: error: could not load input file\n", inputFile);
         return 1;
     }
 
-    printf(">>> GENERATING MODULE \"%s\"\n", moduleName);
-    
-    /* Parse the file */
-    TreeNode* rootNode = ParseFile(inputFileBuffer, inputFileSize, moduleName);
+    double loadSeconds = nkgen_time_seconds() - phaseStart;
+
+    Note(NKGEN_DIAGNOSTIC_INFO, diagnosticLevel, "generating module \"%s\"", moduleName);
+
+    NkGenOptions options = {
+        .moduleName = moduleName,
+        .inputPath = inputFile,
+        .headerPath = outputHeader,
+        .sourcePath = outputSource,
+        .backend = backend,
+        .staticLinks = staticLinks,
+        .precomputeLayout = precomputeLayout,
+        .poolConstants = poolConstants,
+        .inlineSubtrees = inlineSubtrees,
+        .sourceChunks = sourceChunks,
+        .opaqueHeader = opaqueHeader,
+        .viewIds = viewIds,
+        .routeEvents = routeEvents,
+        .hotColdMembers = hotColdMembers,
+        .diagnosticLevel = diagnosticLevel,
+        .dumpTree = treeDumpFile != NULL,
+        .footprint = footprintFile != NULL
+    };
+
+    NkGenOutput output;
+    NkGenResult result = nkgen_generate(inputFileBuffer, inputFileSize, &options, &output);
+
+    free(inputFileBuffer);
 
-    printf("ABOUT TO VALIDATE TREE\n");
-    ValidateTree(rootNode);
+    PrintDiagnostics(&output);
+
+    /* written before checking the result, an invalid tree is what it is most useful for */
+    if (treeDumpFile && output.treeDump && WriteOutputFile(treeDumpFile, output.treeDump, output.treeDumpSize))
+    {
+        fprintf(stderr, "%s: error: could not write tree dump\n", treeDumpFile);
+        nkgen_free_output(&output);
+        return 1;
+    }
+
+    if (result != NKGEN_OK)
+    {
+        fprintf(stderr, "nkgen: error: could not generate module \"%s\": %s\n", moduleName, nkgen_result_string(result));
+        nkgen_free_output(&output);
+        return 1;
+    }
+
+    output.stats.phaseSeconds[NKGEN_PHASE_LOAD] = loadSeconds;
+
+    phaseStart = nkgen_time_seconds();
 
     /* Write the header file */
-    WriteHeaderFile(outputHeader, moduleName, rootNode);
+    if (WriteOutputFile(outputHeader, output.header, output.headerSize))
+    {
+        fprintf(stderr, "%s: error: could not open header file for writing\n", outputHeader);
+        nkgen_free_output(&output);
+        return 1;
+    }
+
+    Note(NKGEN_DIAGNOSTIC_INFO, diagnosticLevel, "wrote header file %s", outputHeader);
 
     /* Write the source file */
-    WriteSourceFile(outputSource, moduleName, rootNode);
+    if (WriteOutputFile(outputSource, output.source, output.sourceSize))
+    {
+        fprintf(stderr, "%s: error: could not open source file for writing\n", outputSource);
+        nkgen_free_output(&output);
+        return 1;
+    }
+
+    Note(NKGEN_DIAGNOSTIC_INFO, diagnosticLevel, "wrote source file %s", outputSource);
 
-    /* Free the input file buffer */
-    //free(inputFileBuffer);
-    
-    //FreeFile(rootNode);
-    
-    printf("<<< DONE\n");
+    /* Write the chunks _Create was split over, and the list of every source the module compiles */
+    for (size_t i = 0; i < output.chunkCount; i++)
+    {
+        char chunkPath[512];
+
+        if (!nkgen_chunk_path(outputSource, i + 1, chunkPath, sizeof(chunkPath)) || WriteOutputFile(chunkPath, output.chunks[i], output.chunkSizes[i]))
+        {
+            fprintf(stderr, "%s: error: could not write source chunk %zu\n", outputSource, i + 1);
+            nkgen_free_output(&output);
+            return 1;
+        }
+
+        Note(NKGEN_DIAGNOSTIC_INFO, diagnosticLevel, "wrote source chunk %s", chunkPath);
+    }
+
+    if (sourceChunks > 0)
+    {
+        char manifestPath[512];
+        size_t length = strlen(outputSource);
+
+        if (length >= 2 && strcmp(outputSource + length - 2, ".c") == 0)
+        {
+            length -= 2;
+        }
+
+        snprintf(manifestPath, sizeof(manifestPath), "%.*s.sources", (int)length, outputSource);
+
+        if (WriteManifest(manifestPath, outputSource, &output))
+        {
+            fprintf(stderr, "%s: error: could not write source manifest\n", manifestPath);
+            nkgen_free_output(&output);
+            return 1;
+        }
+
+        Note(NKGEN_DIAGNOSTIC_INFO, diagnosticLevel, "wrote source manifest %s", manifestPath);
+    }
+
+    /* Write the footprint manifest, left unchanged when the members are so review only sees real growth */
+    if (footprintFile)
+    {
+        if (!output.footprint || WriteOutputFile(footprintFile, output.footprint, output.footprintSize))
+        {
+            fprintf(stderr, "%s: error: could not write footprint manifest\n", footprintFile);
+            nkgen_free_output(&output);
+            return 1;
+        }
+
+        Note(NKGEN_DIAGNOSTIC_INFO, diagnosticLevel, "wrote footprint manifest %s", footprintFile);
+    }
+
+    /* Write the dependency file, its target is the stamp when the build tracks one */
+    if (depFile && WriteDepFile(depFile, stampFile ? stampFile : outputHeader, inputFile, &output))
+    {
+        fprintf(stderr, "%s: error: could not write dependency file\n", depFile);
+        nkgen_free_output(&output);
+        return 1;
+    }
+
+    /* Write the stamp last and always, the outputs left unchanged keep their timestamps
+       while the stamp tells the build this run is up to date */
+    if (stampFile && WriteStampFile(stampFile, moduleName))
+    {
+        fprintf(stderr, "%s: error: could not write stamp file\n", stampFile);
+        nkgen_free_output(&output);
+        return 1;
+    }
+
+    output.stats.phaseSeconds[NKGEN_PHASE_WRITE] = nkgen_time_seconds() - phaseStart;
+
+    if (printStats)
+    {
+        PrintStats(moduleName, &output);
+    }
+
+    if (statsJson && AppendStatsJson(statsJson, moduleName, inputFile, &output))
+    {
+        fprintf(stderr, "%s: error: could not write statistics\n", statsJson);
+        nkgen_free_output(&output);
+        return 1;
+    }
+
+    nkgen_free_output(&output);
+
+    Note(NKGEN_DIAGNOSTIC_INFO, diagnosticLevel, "done with module \"%s\"", moduleName);
 
     return 0;
 }
@@ -100,7 +402,6 @@ int LoadFile(const char* path, char** buffer, size_t* size)
     FILE *inputFileHandle = fopen(path, "r");
 
     if (!inputFileHandle) {
-        fprintf(stderr, "Error: Could not open input file\n");
         return 1;
     }
 
@@ -111,7 +412,6 @@ int LoadFile(const char* path, char** buffer, size_t* size)
     char* fileBuffer = (char *)malloc(fileSize + 1);
 
     if (!fileBuffer) {
-        fprintf(stderr, "Error: Could not allocate memory for input buffer\n");
         fclose(inputFileHandle);
         return 1;
     }
@@ -126,3 +426,292 @@ int LoadFile(const char* path, char** buffer, size_t* size)
 
     return 0;
 }
+
+int WriteOutputFile(const char* path, const char* contents, size_t size)
+{
+    /* an output that did not change keeps its timestamp, so nothing including it is rebuilt */
+    if (SameFileContents(path, contents, size))
+    {
+        return 0;
+    }
+
+    FILE *outputFileHandle = fopen(path, "w");
+
+    if (!outputFileHandle) {
+        return 1;
+    }
+
+    size_t written = fwrite(contents, 1, size, outputFileHandle);
+    fclose(outputFileHandle);
+
+    return (written == size) ? 0 : 1;
+}
+
+static bool SameFileContents(const char* path, const char* contents, size_t size)
+{
+    FILE *existingFileHandle = fopen(path, "rb");
+
+    if (!existingFileHandle) {
+        return false;
+    }
+
+    char block[16 * 1024];
+    size_t compared = 0;
+    bool same = true;
+
+    while (same)
+    {
+        size_t read = fread(block, 1, sizeof(block), existingFileHandle);
+
+        if (read == 0) break;
+
+        same = compared + read <= size && memcmp(block, contents + compared, read) == 0;
+        compared += read;
+    }
+
+    same = same && compared == size && !ferror(existingFileHandle);
+    fclose(existingFileHandle);
+
+    return same;
+}
+
+int WriteDepFile(const char* path, const char* target, const char* inputFile, const NkGenOutput* output)
+{
+    FILE *depFileHandle = fopen(path, "w");
+
+    if (!depFileHandle) {
+        return 1;
+    }
+
+    WriteDepFilePath(depFileHandle, target);
+    fprintf(depFileHandle, ": ");
+    WriteDepFilePath(depFileHandle, inputFile);
+
+    for (size_t i = 0; i < output->dependencyCount; i++)
+    {
+        fprintf(depFileHandle, " \\\n  ");
+        WriteDepFilePath(depFileHandle, output->dependencies[i]);
+    }
+
+    fprintf(depFileHandle, "\n");
+    fclose(depFileHandle);
+
+    return 0;
+}
+
+int WriteManifest(const char* path, const char* outputSource, const NkGenOutput* output)
+{
+    /* one path per line, the module source first */
+    FILE *manifestFileHandle = fopen(path, "w");
+
+    if (!manifestFileHandle) {
+        return 1;
+    }
+
+    fprintf(manifestFileHandle, "%s\n", outputSource);
+
+    for (size_t i = 0; i < output->chunkCount; i++)
+    {
+        char chunkPath[512];
+        nkgen_chunk_path(outputSource, i + 1, chunkPath, sizeof(chunkPath));
+        fprintf(manifestFileHandle, "%s\n", chunkPath);
+    }
+
+    return fclose(manifestFileHandle) == 0 ? 0 : 1;
+}
+
+int WriteStampFile(const char* path, const char* moduleName)
+{
+    FILE *stampFileHandle = fopen(path, "w");
+
+    if (!stampFileHandle) {
+        return 1;
+    }
+
+    fprintf(stampFileHandle, "%s\n", moduleName);
+
+    return fclose(stampFileHandle) == 0 ? 0 : 1;
+}
+
+int WriteUnityFile(const char* path, char* const* sources, int sourceCount)
+{
+    FILE *unityFileHandle = fopen(path, "w");
+
+    if (!unityFileHandle) {
+        return 1;
+    }
+
+    fprintf(unityFileHandle,
+"/***************************************************************\n\
+**\n\
+** NanoKit Generated Source File\n\
+**\n\
+** File         :  %s\n\
+** Sources      :  %d, compiled as one translation unit\n\
+**\n\
+***************************************************************/\n\
+\n",
+        path,
+        sourceCount
+    );
+
+    /* every generated symbol is prefixed with its module and shared support code is guarded,
+       so the sources can be included one after another */
+    for (int i = 0; i < sourceCount; i++)
+    {
+        fprintf(unityFileHandle, "#include \"");
+
+        for (size_t j = 0; sources[i][j] != '\0'; j++)
+        {
+            fputc((sources[i][j] == '\\') ? '/' : sources[i][j], unityFileHandle);
+        }
+
+        fprintf(unityFileHandle, "\"\n");
+    }
+
+    return fclose(unityFileHandle) == 0 ? 0 : 1;
+}
+
+static void WriteDepFilePath(FILE* file, const char* path)
+{
+    /* make syntax, spaces and hashes are escaped */
+    for (size_t i = 0; path[i] != '\0'; i++)
+    {
+        if (path[i] == ' ' || path[i] == '#')
+        {
+            fputc('\\', file);
+        }
+        else if (path[i] == '$')
+        {
+            fputc('$', file);
+        }
+
+        fputc(path[i], file);
+    }
+}
+
+static void PrintStats(const char* moduleName, const NkGenOutput* output)
+{
+    const NkGenStats* stats = &output->stats;
+    double totalSeconds = 0.0;
+
+    fprintf(stderr, "nkgen stats for module \"%s\"\n", moduleName);
+
+    for (size_t phase = 0; phase < NKGEN_PHASE_COUNT; phase++)
+    {
+        totalSeconds += stats->phaseSeconds[phase];
+        fprintf(stderr, "    %-12s %10.3f ms\n", nkgen_phase_name((NkGenPhase)phase), stats->phaseSeconds[phase] * 1000.0);
+    }
+
+    fprintf(stderr, "    %-12s %10.3f ms\n", "total", totalSeconds * 1000.0);
+    fprintf(stderr, "    %-12s %10zu nodes, %zu properties\n", "tree", stats->nodeCount, stats->propertyCount);
+    fprintf(stderr, "    %-12s %10zu bytes in, %zu header bytes, %zu source bytes\n", "size", stats->inputSize, output->headerSize, output->sourceSize);
+    fprintf(stderr, "    %-12s %10zu helpers, %zu source bytes saved\n", "shared", stats->sharedHelperCount, stats->sharedBytesSaved);
+    fprintf(stderr, "    %-12s %10zu calls, %zu bytes\n", "allocations", stats->allocationCount, stats->allocationBytes);
+    fprintf(stderr, "    %-12s %10zu KB\n", "peak rss", stats->peakRssBytes / 1024);
+}
+
+static int AppendStatsJson(const char* path, const char* moduleName, const char* inputFile, const NkGenOutput* output)
+{
+    /* one line per module, appended so a whole build can share the file */
+    FILE *statsFileHandle = fopen(path, "a");
+
+    if (!statsFileHandle) {
+        return 1;
+    }
+
+    const NkGenStats* stats = &output->stats;
+    double totalSeconds = 0.0;
+
+    fprintf(statsFileHandle, "{\"module\":");
+    WriteJsonString(statsFileHandle, moduleName);
+    fprintf(statsFileHandle, ",\"input\":");
+    WriteJsonString(statsFileHandle, inputFile);
+    fprintf(statsFileHandle, ",\"phases_ms\":{");
+
+    for (size_t phase = 0; phase < NKGEN_PHASE_COUNT; phase++)
+    {
+        totalSeconds += stats->phaseSeconds[phase];
+        fprintf(statsFileHandle, "%s\"%s\":%.6f", (phase == 0) ? "" : ",", nkgen_phase_name((NkGenPhase)phase), stats->phaseSeconds[phase] * 1000.0);
+    }
+
+    fprintf(statsFileHandle, "},\"total_ms\":%.6f,\"nodes\":%zu,\"properties\":%zu,\"input_bytes\":%zu,\"header_bytes\":%zu,\"source_bytes\":%zu,\"shared_helpers\":%zu,\"shared_bytes_saved\":%zu,\"alloc_calls\":%zu,\"alloc_bytes\":%zu,\"peak_rss_bytes\":%zu}\n",
+        totalSeconds * 1000.0,
+        stats->nodeCount,
+        stats->propertyCount,
+        stats->inputSize,
+        output->headerSize,
+        output->sourceSize,
+        stats->sharedHelperCount,
+        stats->sharedBytesSaved,
+        stats->allocationCount,
+        stats->allocationBytes,
+        stats->peakRssBytes
+    );
+
+    return fclose(statsFileHandle) == 0 ? 0 : 1;
+}
+
+static void WriteJsonString(FILE* file, const char* string)
+{
+    fputc('"', file);
+
+    for (size_t i = 0; string[i] != '\0'; i++)
+    {
+        unsigned char character = (unsigned char)string[i];
+
+        if (character == '"' || character == '\\')
+        {
+            fputc('\\', file);
+            fputc(character, file);
+        }
+        else if (character < 0x20)
+        {
+            fprintf(file, "\\u%04x", character);
+        }
+        else
+        {
+            fputc(character, file);
+        }
+    }
+
+    fputc('"', file);
+}
+
+static void PrintDiagnostics(const NkGenOutput* output)
+{
+    /* compiler style file:line:column so editors can jump to the markup */
+    for (size_t i = 0; i < output->diagnosticCount; i++)
+    {
+        const NkGenDiagnostic* diagnostic = &output->diagnostics[i];
+
+        if (!diagnostic->file)
+        {
+            fprintf(stderr, "nkgen: ");
+        }
+        else if (diagnostic->line == 0)
+        {
+            fprintf(stderr, "%s: ", diagnostic->file);
+        }
+        else
+        {
+            fprintf(stderr, "%s:%u:%u: ", diagnostic->file, (unsigned)diagnostic->line, (unsigned)diagnostic->column);
+        }
+
+        fprintf(stderr, "%s: %s\n", nkgen_diagnostic_level_name(diagnostic->level), diagnostic->message);
+    }
+}
+
+static void Note(NkGenDiagnosticLevel level, NkGenDiagnosticLevel maximumLevel, const char* format, ...)
+{
+    if (level > maximumLevel) return;
+
+    va_list arguments;
+    va_start(arguments, format);
+
+    fprintf(stderr, "nkgen: %s: ", nkgen_diagnostic_level_name(level));
+    vfprintf(stderr, format, arguments);
+    fprintf(stderr, "\n");
+
+    va_end(arguments);
+}
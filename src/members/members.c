@@ -0,0 +1,333 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  members.c
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen member order of the module struct and its footprint manifest
+**
+***************************************************************/
+
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stats/alloc.h>
+
+#include <buffer/buffer.h>
+#include <translator/translator.h>
+#include <binding/binding.h>
+#include <items/items.h>
+
+#include "members.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* Views of one type in the manifest summary */
+typedef struct
+{
+    const TreeNode* node;   /* first member of the type, the type is written from it */
+    size_t count;
+} TypeCount;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static Member* members = NULL;
+static size_t memberCount = 0;
+static size_t memberCapacity = 0;
+
+static bool reordered = false;
+
+static const char* groupNames[] = {
+    [MEMBER_ROOT] = "root",
+    [MEMBER_CONTAINER] = "container",
+    [MEMBER_LEAF] = "leaf",
+    [MEMBER_DEFERRED] = "deferred"
+};
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static bool AddMembers(const TreeNode* node, bool inDeferred);
+static void WriteFootprintRow(OutputBuffer* output, const char* moduleName, int nameWidth, int typeWidth, const char* name, const char* type, size_t count, const char* group);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool CollectMembers(const TreeNode* rootNode, bool hotCold)
+{
+    ClearMembers();
+
+    if (!rootNode) return true;
+
+    if (!AddMembers(rootNode, false))
+    {
+        ClearMembers();
+        return false;
+    }
+
+    members[0].group = MEMBER_ROOT;
+
+    if (!hotCold) return true;
+
+    /* a stable partition by group, every group keeps the document order of its members */
+    Member* ordered = (Member*)malloc(memberCount * sizeof(Member));
+
+    if (!ordered)
+    {
+        ClearMembers();
+        return false;
+    }
+
+    size_t count = 0;
+
+    for (MemberGroup group = MEMBER_ROOT; group <= MEMBER_DEFERRED; group++)
+    {
+        for (size_t i = 0; i < memberCount; i++)
+        {
+            if (members[i].group == group) ordered[count++] = members[i];
+        }
+    }
+
+    for (size_t i = 0; i < memberCount && !reordered; i++)
+    {
+        reordered = ordered[i].node != members[i].node;
+    }
+
+    free(members);
+    members = ordered;
+    memberCapacity = memberCount;
+
+    return true;
+}
+
+void ClearMembers(void)
+{
+    free(members);
+
+    members = NULL;
+    memberCount = 0;
+    memberCapacity = 0;
+    reordered = false;
+}
+
+size_t GetMemberCount(void)
+{
+    return memberCount;
+}
+
+const Member* GetMember(size_t index)
+{
+    return (index < memberCount) ? &members[index] : NULL;
+}
+
+bool IsHotColdOrder(void)
+{
+    return reordered;
+}
+
+char* GenerateFootprint(const char* moduleName, size_t* size)
+{
+    OutputBuffer output;
+    BufferInit(&output, 4096);
+
+    char moduleUpper[256];
+    size_t length = 0;
+
+    for (; moduleName[length] != '\0' && length < sizeof(moduleUpper) - 1; length++)
+    {
+        char c = moduleName[length];
+        moduleUpper[length] = (c >= 'a' && c <= 'z') ? c - 32 : c;
+    }
+    moduleUpper[length] = '\0';
+
+    /* names are padded to the longest so a diff of two manifests lines up */
+    int nameWidth = (int)strlen("member");
+    int typeWidth = (int)strlen("type");
+
+    char type[256];
+    char otherType[256];
+
+    for (size_t i = 0; i < memberCount; i++)
+    {
+        int nameLength = (int)strlen(members[i].node->instanceName);
+        int typeLength = (int)strlen(MemberType(members[i].node, type, sizeof(type)));
+
+        if (nameLength > nameWidth) nameWidth = nameLength;
+        if (typeLength > typeWidth) typeWidth = typeLength;
+    }
+
+    for (size_t i = 0; i < GetListCount(); i++)
+    {
+        /* <list>Rows of <module>_<list>Row_t */
+        int listLength = (int)strlen(GetList(i)->instanceName);
+
+        if (listLength + 4 > nameWidth) nameWidth = listLength + 4;
+        if ((int)strlen(moduleName) + listLength + 6 > typeWidth) typeWidth = (int)strlen(moduleName) + listLength + 6;
+    }
+
+    if (GetBindingPathCount() > 0 && (int)strlen(moduleName) + 12 > typeWidth)
+    {
+        typeWidth = (int)strlen(moduleName) + 12;
+    }
+
+    BufferPrintf(&output,
+        "# nkgen footprint of %s_t, members in declaration order (%s)\n"
+        "# offset and size are the expressions the generated source asserts, their bytes are the compiler's,\n"
+        "# %s_GetFootprint gives each member's and the total sizeof(%s_t), define %s_XML_FOOTPRINT_LIMIT to cap that total\n\n",
+        moduleName,
+        reordered ? "hot-cold" : "document",
+        moduleName,
+        moduleName,
+        moduleUpper
+    );
+
+    BufferPrintf(&output, "%-*s  %-*s  %5s  %-9s  %-*s  %s\n", nameWidth, "member", typeWidth, "type", "count", "group", (int)strlen(moduleName) + nameWidth + 14, "offset", "size");
+
+    TypeCount* types = (TypeCount*)calloc(memberCount ? memberCount : 1, sizeof(TypeCount));
+    size_t typeCount = 0;
+    size_t viewCount = 0;
+    size_t arrayCount = 0;
+
+    for (size_t i = 0; i < memberCount; i++)
+    {
+        const TreeNode* node = members[i].node;
+        size_t count = node->repeatCount ? node->repeatCount : 1;
+
+        WriteFootprintRow(&output, moduleName, nameWidth, typeWidth, node->instanceName, MemberType(node, type, sizeof(type)), count, groupNames[members[i].group]);
+
+        viewCount += count;
+        arrayCount += node->repeatCount ? 1 : 0;
+
+        if (!types) continue;
+
+        size_t t = 0;
+        while (t < typeCount && strcmp(MemberType(types[t].node, otherType, sizeof(otherType)), type) != 0) t++;
+
+        if (t == typeCount)
+        {
+            types[typeCount++] = (TypeCount){ node, 0 };
+        }
+
+        types[t].count += count;
+    }
+
+    /* the state after the views, the row pools grow with PoolSize rather than with the markup */
+    for (size_t i = 0; i < GetListCount(); i++)
+    {
+        const TreeNode* list = GetList(i);
+        char rowName[256];
+        char rowType[512];
+
+        snprintf(rowName, sizeof(rowName), "%sRows", list->instanceName);
+        snprintf(rowType, sizeof(rowType), "%s_%sRow_t", moduleName, list->instanceName);
+
+        WriteFootprintRow(&output, moduleName, nameWidth, typeWidth, rowName, rowType, list->items->poolSize, "rows");
+    }
+
+    if (GetBindingPathCount() > 0)
+    {
+        char modelType[256];
+        snprintf(modelType, sizeof(modelType), "%s_ViewModel_t", moduleName);
+
+        WriteFootprintRow(&output, moduleName, nameWidth, typeWidth, "model", modelType, 1, "state");
+    }
+
+    BufferPrintf(&output, "\n# views by type\n");
+
+    for (size_t t = 0; types && t < typeCount; t++)
+    {
+        BufferPrintf(&output, "%-*s  %5zu\n", typeWidth, MemberType(types[t].node, type, sizeof(type)), types[t].count);
+    }
+
+    BufferPrintf(&output, "\n# %zu members, %zu views, %zu arrays\n", memberCount, viewCount, arrayCount);
+
+    free(types);
+
+    return BufferRelease(&output, size);
+}
+
+const char* MemberType(const TreeNode* node, char* buffer, size_t size)
+{
+    /* a UserControl member is that module's struct */
+    if (node->component)
+    {
+        snprintf(buffer, size, "%s_t", node->component);
+    }
+    else
+    {
+        snprintf(buffer, size, "%s", TranslateClassName(node->className));
+    }
+
+    return buffer;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static bool AddMembers(const TreeNode* node, bool inDeferred)
+{
+    if (memberCount == memberCapacity)
+    {
+        size_t capacity = memberCapacity ? memberCapacity * 2 : 64;
+        Member* grown = (Member*)realloc(members, capacity * sizeof(Member));
+
+        if (!grown) return false;
+
+        members = grown;
+        memberCapacity = capacity;
+    }
+
+    inDeferred = inDeferred || node->deferred;
+
+    /* a UserControl orders its own members, here it is a single leaf */
+    MemberGroup group = inDeferred ? MEMBER_DEFERRED : (node->child && !node->component) ? MEMBER_CONTAINER : MEMBER_LEAF;
+
+    members[memberCount++] = (Member){ node, group };
+
+    for (const TreeNode* child = node->child; child != NULL; child = child->sibling)
+    {
+        if (!AddMembers(child, inDeferred)) return false;
+    }
+
+    return true;
+}
+
+static void WriteFootprintRow(OutputBuffer* output, const char* moduleName, int nameWidth, int typeWidth, const char* name, const char* type, size_t count, const char* group)
+{
+    /* the same sizeof and offsetof the generated source checks, an array is its count times the element */
+    char offset[768];
+    char size[320];
+
+    snprintf(offset, sizeof(offset), "offsetof(%s_t, %s)", moduleName, name);
+
+    if (count > 1)
+    {
+        snprintf(size, sizeof(size), "%zu * sizeof(%s)", count, type);
+    }
+    else
+    {
+        snprintf(size, sizeof(size), "sizeof(%s)", type);
+    }
+
+    BufferPrintf(output, "%-*s  %-*s  %5zu  %-9s  %-*s  %s\n", nameWidth, name, typeWidth, type, count, group, (int)strlen(moduleName) + nameWidth + 14, offset, size);
+}
@@ -0,0 +1,73 @@
+/***************************************************************
+**
+** NanoKit Tool Header File
+**
+** File         :  members.h
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen member order of the module struct and its footprint manifest
+**
+***************************************************************/
+
+#ifndef MEMBERS_H
+#define MEMBERS_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <parser/parser.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* How often a member is touched once the module is built, hot-cold order keeps the groups in this order */
+typedef enum
+{
+    MEMBER_ROOT,        /* the module's own view, always first so the struct starts with it */
+    MEMBER_CONTAINER,   /* has children, walked by every measure and arrange pass */
+    MEMBER_LEAF,        /* measured and drawn, reached from its container */
+    MEMBER_DEFERRED     /* inside a Defer="True" subtree, untouched until realized */
+} MemberGroup;
+
+typedef struct
+{
+    const TreeNode* node;
+    MemberGroup group;
+} Member;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* Lists the view members of the module struct, in document pre-order or grouped hot to cold
+   with each group in pre-order, list rows are members of their row struct and not listed */
+bool CollectMembers(const TreeNode* rootNode, bool hotCold);
+void ClearMembers(void);
+
+/* In declaration order, 0 unless members were collected */
+size_t GetMemberCount(void);
+const Member* GetMember(size_t index);
+
+/* True if the declaration order is not the document order */
+bool IsHotColdOrder(void);
+
+/* Text manifest of the members, their types, counts and the sizeof and offsetof the generated source asserts,
+   the byte values are only known to the compiler and come from the generated _GetFootprint */
+char* GenerateFootprint(const char* moduleName, size_t* size);
+
+/* C type of a view member, the UserControl's module struct for a reference */
+const char* MemberType(const TreeNode* node, char* buffer, size_t size);
+
+#endif /* MEMBERS_H */
@@ -0,0 +1,460 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  nkgen.c
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  libnkgen in-memory generation API
+**
+***************************************************************/
+
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stats/alloc.h>
+
+#include <parser/parser.h>
+#include <header/header.h>
+#include <source/source.h>
+#include <translator/translator.h>
+#include <binding/binding.h>
+#include <theme/theme.h>
+#include <items/items.h>
+#include <lookup/lookup.h>
+#include <route/route.h>
+#include <members/members.h>
+#include <layout/layout.h>
+#include <stats/stats.h>
+#include <diagnostics/diagnostics.h>
+
+#include "nkgen.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static NkGenResult Generate(const char* xml, size_t len, const NkGenOptions* options, NkGenOutput* output);
+static NkGenResult CopyDependencies(NkGenOutput* output);
+static void TakeDiagnostics(NkGenOutput* output);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+NkGenResult nkgen_generate(const char* xml, size_t len, const NkGenOptions* options, NkGenOutput* output)
+{
+    if (!output) return NKGEN_ERROR_ARGUMENT;
+
+    memset(output, 0, sizeof(NkGenOutput));
+
+    if (!xml || len == 0 || !options || !options->moduleName || options->sourceChunks > NKGEN_MAX_SOURCE_CHUNKS) return NKGEN_ERROR_ARGUMENT;
+
+    DiagnosticsBegin((DiagnosticLevel)options->diagnosticLevel);
+
+    NkGenResult result = Generate(xml, len, options, output);
+
+    TakeDiagnostics(output);
+
+    return result;
+}
+
+void nkgen_free_output(NkGenOutput* output)
+{
+    if (!output) return;
+
+    free(output->header);
+    free(output->source);
+
+    for (size_t i = 0; i < output->chunkCount; i++)
+    {
+        free(output->chunks[i]);
+    }
+    free(output->chunks);
+    free(output->chunkSizes);
+
+    for (size_t i = 0; i < output->dependencyCount; i++)
+    {
+        free(output->dependencies[i]);
+    }
+    free(output->dependencies);
+
+    for (size_t i = 0; i < output->diagnosticCount; i++)
+    {
+        free(output->diagnostics[i].file);
+        free(output->diagnostics[i].message);
+    }
+    free(output->diagnostics);
+
+    free(output->treeDump);
+    free(output->footprint);
+
+    memset(output, 0, sizeof(NkGenOutput));
+}
+
+void nkgen_clear_cache(void)
+{
+    ClearIncludeCache();
+}
+
+const char* nkgen_result_string(NkGenResult result)
+{
+    switch (result)
+    {
+        case NKGEN_OK:              return "ok";
+        case NKGEN_ERROR_ARGUMENT:  return "invalid argument";
+        case NKGEN_ERROR_PARSE:     return "could not parse input";
+        case NKGEN_ERROR_VALIDATE:  return "invalid class or property";
+        case NKGEN_ERROR_MEMORY:    return "out of memory";
+        default:                    return "unknown error";
+    }
+}
+
+const char* nkgen_phase_name(NkGenPhase phase)
+{
+    switch (phase)
+    {
+        case NKGEN_PHASE_LOAD:      return "load";
+        case NKGEN_PHASE_PARSE:     return "parse";
+        case NKGEN_PHASE_VALIDATE:  return "validate";
+        case NKGEN_PHASE_HEADER:    return "header";
+        case NKGEN_PHASE_SOURCE:    return "source";
+        case NKGEN_PHASE_WRITE:     return "write";
+        default:                    return "unknown";
+    }
+}
+
+const char* nkgen_diagnostic_level_name(NkGenDiagnosticLevel level)
+{
+    switch (level)
+    {
+        case NKGEN_DIAGNOSTIC_ERROR:    return "error";
+        case NKGEN_DIAGNOSTIC_WARNING:  return "warning";
+        case NKGEN_DIAGNOSTIC_INFO:     return "info";
+        case NKGEN_DIAGNOSTIC_DEBUG:    return "debug";
+        default:                        return "unknown";
+    }
+}
+
+bool nkgen_backend_from_name(const char* name, NkGenBackend* backend)
+{
+    if (!name || !backend) return false;
+
+    if (strcmp(name, "unrolled") == 0)
+    {
+        *backend = NKGEN_BACKEND_UNROLLED;
+        return true;
+    }
+
+    if (strcmp(name, "table") == 0)
+    {
+        *backend = NKGEN_BACKEND_TABLE;
+        return true;
+    }
+
+    if (strcmp(name, "prototype") == 0)
+    {
+        *backend = NKGEN_BACKEND_PROTOTYPE;
+        return true;
+    }
+
+    return false;
+}
+
+bool nkgen_chunk_path(const char* sourcePath, size_t chunk, char* buffer, size_t size)
+{
+    if (!sourcePath || !buffer || size == 0) return false;
+
+    /* the number goes before the extension so the chunks still compile as C */
+    size_t length = strlen(sourcePath);
+
+    if (length >= 2 && strcmp(sourcePath + length - 2, ".c") == 0)
+    {
+        length -= 2;
+    }
+
+    int written = snprintf(buffer, size, "%.*s.%zu.c", (int)length, sourcePath, chunk);
+
+    return written > 0 && (size_t)written < size;
+}
+
+double nkgen_time_seconds(void)
+{
+    return StatsNow();
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static NkGenResult Generate(const char* xml, size_t len, const NkGenOptions* options, NkGenOutput* output)
+{
+    char headerPath[512];
+    char sourcePath[512];
+    snprintf(headerPath, sizeof(headerPath), "%s.xml.h", options->moduleName);
+    snprintf(sourcePath, sizeof(sourcePath), "%s.xml.c", options->moduleName);
+
+    NkGenStats* stats = &output->stats;
+    stats->inputSize = len;
+
+    size_t allocationCount = 0;
+    size_t allocationBytes = 0;
+    StatsGetAllocations(&allocationCount, &allocationBytes);
+
+    double phaseStart = StatsNow();
+
+    /* the parser takes ownership of a NUL terminated copy */
+    char* contents = (char*)malloc(len + 1);
+
+    if (!contents) return NKGEN_ERROR_MEMORY;
+
+    memcpy(contents, xml, len);
+    contents[len] = '\0';
+
+    TreeNode* rootNode = ParseFile(contents, len, options->moduleName, options->inputPath);
+
+    stats->phaseSeconds[NKGEN_PHASE_PARSE] = StatsNow() - phaseStart;
+
+    if (!rootNode) return NKGEN_ERROR_PARSE;
+
+    if (options->dumpTree)
+    {
+        output->treeDump = DumpTree(rootNode, &output->treeDumpSize);
+    }
+
+    StatsCountTree(rootNode, &stats->nodeCount, &stats->propertyCount);
+
+    phaseStart = StatsNow();
+    bool isValid = ValidateTree(rootNode);
+    stats->phaseSeconds[NKGEN_PHASE_VALIDATE] = StatsNow() - phaseStart;
+
+    bool withViewIds = options->viewIds || options->routeEvents;
+
+    /* {Binding} paths are typed by the properties they are bound to, so they need a valid tree,
+       view IDs follow the member order and routes are keyed by view ID */
+    if (!isValid || !CollectBindings(rootNode) || !CollectThemes(rootNode) || !CollectLists(rootNode) || !CollectMembers(rootNode, options->hotColdMembers) || (withViewIds && !CollectViewIds(rootNode)) || (options->routeEvents && !CollectRoutes(rootNode)))
+    {
+        ClearBindings();
+        ClearThemes();
+        ClearLists();
+        ClearMembers();
+        ClearViewIds();
+        ClearRoutes();
+        FreeFile(rootNode);
+        return NKGEN_ERROR_VALIDATE;
+    }
+
+    if (options->precomputeLayout)
+    {
+        PrecomputeLayout(rootNode);
+    }
+
+    phaseStart = StatsNow();
+    output->header = GenerateHeaderFile(options->headerPath ? options->headerPath : headerPath, options->moduleName, rootNode, options->opaqueHeader, options->footprint, &output->headerSize);
+
+    /* an opaque header leaves the members to the source, so only the source changes with the layout */
+    char* moduleStruct = NULL;
+
+    if (options->opaqueHeader)
+    {
+        size_t moduleStructSize = 0;
+        moduleStruct = GenerateModuleStruct(options->moduleName, rootNode, &moduleStructSize);
+    }
+
+    if (options->footprint)
+    {
+        output->footprint = GenerateFootprint(options->moduleName, &output->footprintSize);
+    }
+
+    stats->phaseSeconds[NKGEN_PHASE_HEADER] = StatsNow() - phaseStart;
+
+    phaseStart = StatsNow();
+    SourceOptions sourceOptions = {
+        .backend = SOURCE_BACKEND_UNROLLED,
+        .staticLinks = options->staticLinks,
+        .poolConstants = options->poolConstants,
+        .shareSubtrees = !options->inlineSubtrees,
+        .moduleStruct = moduleStruct,
+        .footprint = options->footprint
+    };
+
+    if (options->backend == NKGEN_BACKEND_TABLE)
+    {
+        sourceOptions.backend = SOURCE_BACKEND_TABLE;
+    }
+    else if (options->backend == NKGEN_BACKEND_PROTOTYPE)
+    {
+        sourceOptions.backend = SOURCE_BACKEND_PROTOTYPE;
+    }
+
+    /* the chunk count is fixed by the options alone, so the build knows every source before generating */
+    bool chunksReady = true;
+    char (*chunkPaths)[512] = NULL;
+    const char** chunkPathList = NULL;
+
+    if (options->sourceChunks > 1)
+    {
+        size_t chunkCount = options->sourceChunks - 1;
+
+        chunkPaths = (char (*)[512])malloc(chunkCount * sizeof(*chunkPaths));
+        chunkPathList = (const char**)malloc(chunkCount * sizeof(const char*));
+        output->chunks = (char**)calloc(chunkCount, sizeof(char*));
+        output->chunkSizes = (size_t*)calloc(chunkCount, sizeof(size_t));
+
+        chunksReady = chunkPaths && chunkPathList && output->chunks && output->chunkSizes;
+
+        for (size_t i = 0; chunksReady && i < chunkCount; i++)
+        {
+            nkgen_chunk_path(options->sourcePath ? options->sourcePath : sourcePath, i + 1, chunkPaths[i], sizeof(chunkPaths[i]));
+            chunkPathList[i] = chunkPaths[i];
+        }
+
+        if (chunksReady)
+        {
+            output->chunkCount = chunkCount;
+            sourceOptions.chunkCount = options->sourceChunks;
+            sourceOptions.chunkPaths = chunkPathList;
+        }
+    }
+
+    if (chunksReady && (moduleStruct || !options->opaqueHeader))
+    {
+        output->source = GenerateSourceFile(options->sourcePath ? options->sourcePath : sourcePath, options->moduleName, rootNode, &sourceOptions, &output->sourceSize, output->chunks, output->chunkSizes);
+        GetSharedSubtreeStats(&stats->sharedHelperCount, &stats->sharedBytesSaved);
+    }
+
+    free(chunkPaths);
+    free(chunkPathList);
+    free(moduleStruct);
+
+    for (size_t i = 0; i < output->chunkCount; i++)
+    {
+        chunksReady = chunksReady && output->chunks[i];
+    }
+
+    stats->phaseSeconds[NKGEN_PHASE_SOURCE] = StatsNow() - phaseStart;
+
+    ClearBindings();
+    ClearThemes();
+    ClearLists();
+    ClearMembers();
+    ClearViewIds();
+    ClearRoutes();
+    ClearLayout();
+    FreeFile(rootNode);
+
+    StatsGetAllocations(&stats->allocationCount, &stats->allocationBytes);
+    stats->allocationCount -= allocationCount;
+    stats->allocationBytes -= allocationBytes;
+
+    stats->peakRssBytes = StatsPeakRss();
+
+    if (!output->header || !output->source || !chunksReady || CopyDependencies(output) != NKGEN_OK)
+    {
+        nkgen_free_output(output);
+        return NKGEN_ERROR_MEMORY;
+    }
+
+    if (DiagnosticsErrorCount() > 0)
+    {
+        /* a writer met a value it could not translate, the outputs are not usable */
+        free(output->header);
+        free(output->source);
+        output->header = NULL;
+        output->source = NULL;
+        output->headerSize = 0;
+        output->sourceSize = 0;
+
+        for (size_t i = 0; i < output->chunkCount; i++)
+        {
+            free(output->chunks[i]);
+            output->chunks[i] = NULL;
+            output->chunkSizes[i] = 0;
+        }
+
+        return NKGEN_ERROR_VALIDATE;
+    }
+
+    return NKGEN_OK;
+}
+
+
+static NkGenResult CopyDependencies(NkGenOutput* output)
+{
+    const char* const* dependencies = NULL;
+    size_t dependencyCount = GetFileDependencies(&dependencies);
+
+    if (dependencyCount == 0) return NKGEN_OK;
+
+    output->dependencies = (char**)calloc(dependencyCount, sizeof(char*));
+
+    if (!output->dependencies) return NKGEN_ERROR_MEMORY;
+
+    for (size_t i = 0; i < dependencyCount; i++)
+    {
+        size_t length = strlen(dependencies[i]);
+        output->dependencies[i] = (char*)malloc(length + 1);
+
+        if (!output->dependencies[i]) return NKGEN_ERROR_MEMORY;
+
+        memcpy(output->dependencies[i], dependencies[i], length + 1);
+        output->dependencyCount++;
+    }
+
+    return NKGEN_OK;
+}
+
+static void TakeDiagnostics(NkGenOutput* output)
+{
+    /* strings move across, only the array is converted */
+    size_t count = 0;
+    Diagnostic* diagnostics = DiagnosticsTake(&count);
+
+    output->errorCount = DiagnosticsErrorCount();
+
+    if (count == 0)
+    {
+        free(diagnostics);
+        return;
+    }
+
+    output->diagnostics = (NkGenDiagnostic*)malloc(count * sizeof(NkGenDiagnostic));
+
+    if (!output->diagnostics)
+    {
+        DiagnosticsFree(diagnostics, count);
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        output->diagnostics[i].level = (NkGenDiagnosticLevel)diagnostics[i].level;
+        output->diagnostics[i].file = diagnostics[i].file;
+        output->diagnostics[i].line = diagnostics[i].line;
+        output->diagnostics[i].column = diagnostics[i].column;
+        output->diagnostics[i].message = diagnostics[i].message;
+    }
+
+    output->diagnosticCount = count;
+    free(diagnostics);
+}
@@ -0,0 +1,193 @@
+/***************************************************************
+**
+** NanoKit Tool Header File
+**
+** File         :  nkgen.h
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  libnkgen in-memory generation API
+**
+***************************************************************/
+
+#ifndef NKGEN_H
+#define NKGEN_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#if defined(_WIN32) && defined(NKGEN_SHARED)
+    #ifdef NKGEN_BUILD
+        #define NKGEN_API __declspec(dllexport)
+    #else
+        #define NKGEN_API __declspec(dllimport)
+    #endif
+#else
+    #define NKGEN_API
+#endif
+
+/* Most sources one module's _Create may be split over */
+#define NKGEN_MAX_SOURCE_CHUNKS 64
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef enum
+{
+    NKGEN_OK = 0,
+    NKGEN_ERROR_ARGUMENT,       /* missing module name, input or output */
+    NKGEN_ERROR_PARSE,          /* malformed XML or an unresolvable <Include> */
+    NKGEN_ERROR_VALIDATE,       /* unknown class or property */
+    NKGEN_ERROR_MEMORY
+} NkGenResult;
+
+typedef enum
+{
+    NKGEN_PHASE_LOAD,           /* reading the markup, timed by the caller */
+    NKGEN_PHASE_PARSE,
+    NKGEN_PHASE_VALIDATE,
+    NKGEN_PHASE_HEADER,
+    NKGEN_PHASE_SOURCE,
+    NKGEN_PHASE_WRITE,          /* writing the outputs, timed by the caller */
+    NKGEN_PHASE_COUNT
+} NkGenPhase;
+
+typedef enum
+{
+    NKGEN_BACKEND_UNROLLED = 0, /* one statement per constructor, property and link in _Create */
+    NKGEN_BACKEND_TABLE,        /* const descriptor tables walked by a small builder loop, for large layouts */
+    NKGEN_BACKEND_PROTOTYPE     /* constant fields copied from a const image of the module struct after the constructors */
+} NkGenBackend;
+
+/* Ordered by verbosity, errors are always reported */
+typedef enum
+{
+    NKGEN_DIAGNOSTIC_ERROR = 0,
+    NKGEN_DIAGNOSTIC_WARNING,   /* unknown enum values that fell back to a default */
+    NKGEN_DIAGNOSTIC_INFO,
+    NKGEN_DIAGNOSTIC_DEBUG      /* per property tracing, only formatted when requested */
+} NkGenDiagnosticLevel;
+
+typedef struct
+{
+    NkGenDiagnosticLevel level;
+    char* file;                 /* NULL for in-memory input without an inputPath */
+    uint32_t line;              /* 1 based, 0 if the message has no position */
+    uint32_t column;            /* 1 based byte column */
+    char* message;
+} NkGenDiagnostic;
+
+typedef struct
+{
+    double phaseSeconds[NKGEN_PHASE_COUNT];
+
+    size_t inputSize;
+    size_t nodeCount;
+    size_t propertyCount;
+
+    size_t sharedHelperCount;   /* init helpers identical subtrees are written through */
+    size_t sharedBytesSaved;    /* source bytes those helpers saved over writing every subtree inline */
+
+    size_t allocationCount;     /* malloc, calloc and realloc calls made by the generator */
+    size_t allocationBytes;     /* bytes requested by those calls */
+
+    size_t peakRssBytes;        /* process peak resident set size after generation, 0 if unknown */
+} NkGenStats;
+
+typedef struct
+{
+    const char* moduleName;     /* prefix of the generated types and functions */
+    const char* inputPath;      /* path of the markup, <Include> resolves relative to it (optional) */
+    const char* headerPath;     /* written into the generated banners (optional) */
+    const char* sourcePath;     /* written into the generated banners (optional) */
+
+    NkGenBackend backend;       /* how _Create builds the view tree */
+    bool staticLinks;           /* store the view hierarchy directly instead of calling nkView_AddChildView */
+    bool precomputeLayout;      /* arrange subtrees sized by constants at generation time */
+    bool poolConstants;         /* share repeated strings and hex colours through one static const pool */
+    bool inlineSubtrees;        /* write identical subtrees out in full instead of calling one shared init helper */
+    uint32_t sourceChunks;      /* spread _Create over this many sources for parallel compiles, the module source included, 0 or 1 keeps one */
+    bool opaqueHeader;          /* forward declare the module struct and define it in the source, named views are reached through accessors */
+    bool viewIds;               /* number the member views and generate _FindByName over a perfect hash of their names */
+    bool routeEvents;           /* route callbacks through a static table and a generated _Dispatch instead of per-view stores, implies viewIds */
+    bool hotColdMembers;        /* declare containers first, then leaves, then deferred views instead of in document order */
+
+    NkGenDiagnosticLevel diagnosticLevel;   /* most verbose level collected, zero keeps errors only */
+    bool dumpTree;              /* fill treeDump with the parsed tree */
+    bool footprint;             /* fill footprint with the member manifest and generate _GetFootprint */
+} NkGenOptions;
+
+typedef struct
+{
+    char* header;               /* generated header, NUL terminated */
+    size_t headerSize;
+
+    char* source;               /* generated source, NUL terminated */
+    size_t sourceSize;
+
+    char** chunks;              /* sourceChunks - 1 further sources when splitting, named by nkgen_chunk_path */
+    size_t* chunkSizes;
+    size_t chunkCount;
+
+    char** dependencies;        /* files pulled in through <Include> */
+    size_t dependencyCount;
+
+    NkGenDiagnostic* diagnostics;   /* in the order they were raised, also set when generation fails */
+    size_t diagnosticCount;
+    size_t errorCount;
+
+    char* treeDump;             /* one line per node: depth, class, name, position, key=value fields */
+    size_t treeDumpSize;
+
+    char* footprint;            /* one line per struct member: name, type, count, group, then the views by type */
+    size_t footprintSize;
+
+    NkGenStats stats;
+} NkGenOutput;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* Generates one module from markup in memory, release the output with nkgen_free_output even on failure,
+   the parser and emitters keep their state in statics, so calls are neither reentrant nor thread-safe
+   and must be serialized by the caller, including against nkgen_clear_cache */
+NKGEN_API NkGenResult nkgen_generate(const char* xml, size_t len, const NkGenOptions* options, NkGenOutput* output);
+NKGEN_API void nkgen_free_output(NkGenOutput* output);
+
+/* Included files are parsed once per process, call this when they may have changed on disk */
+NKGEN_API void nkgen_clear_cache(void);
+
+NKGEN_API const char* nkgen_result_string(NkGenResult result);
+NKGEN_API const char* nkgen_phase_name(NkGenPhase phase);
+NKGEN_API const char* nkgen_diagnostic_level_name(NkGenDiagnosticLevel level);
+
+/* Parses "unrolled", "table" or "prototype", false if the name is unknown */
+NKGEN_API bool nkgen_backend_from_name(const char* name, NkGenBackend* backend);
+
+/* Path of the chunk-th extra source, 1 based, "Main.xml.c" gives "Main.xml.1.c", false if it does not fit */
+NKGEN_API bool nkgen_chunk_path(const char* sourcePath, size_t chunk, char* buffer, size_t size);
+
+/* Monotonic clock in seconds, used for the phase timings */
+NKGEN_API double nkgen_time_seconds(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NKGEN_H */
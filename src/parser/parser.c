@@ -18,8 +18,13 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <ctype.h>
+
+#include <stats/alloc.h>
 
 #include <xml/xml.h>
+#include <buffer/buffer.h>
+#include <diagnostics/diagnostics.h>
 
 #include "parser.h"
 
@@ -27,6 +32,13 @@
 ** MARK: CONSTANTS & MACROS
 ***************************************************************/
 
+#define ITEMS_DEFAULT_POOL_SIZE 32
+#define ITEMS_MAX_POOL_SIZE 4096
+
+#define REPEAT_MAX_COUNT 65536
+
+#define NAME_HASH_DIGITS 6      /* hex digits of the path hash in a default name below the root */
+
 /***************************************************************
 ** MARK: TYPEDEFS
 ***************************************************************/
@@ -36,6 +48,28 @@ struct xml_string {
 	size_t length;
 };
 
+/* A file pulled in through <Include>, parsed once and shared by every splice */
+typedef struct IncludeEntry
+{
+    struct IncludeEntry* next;
+
+    char* path;                 /* normalised path, also the cache key */
+    TreeNode* root;             /* immutable parsed tree, NULL if parsing failed */
+    bool loading;               /* set while the file is being parsed, meeting it again is a cycle */
+
+    char** dependencies;        /* files this one includes, transitively */
+    size_t dependencyCount;
+} IncludeEntry;
+
+/* An <Include> spliced into the module, kept until the names are checked so a repeated name can point at it */
+typedef struct
+{
+    const TreeNode* root;       /* clone of the included tree */
+    const char* file;           /* file of the <Include> element, borrowed */
+    uint32_t line;
+    uint32_t column;
+} IncludeSite;
+
 /***************************************************************
 ** MARK: STATIC VARIABLES
 ***************************************************************/
@@ -43,15 +77,83 @@ struct xml_string {
 static TreeNode* rootNode = NULL;
 static size_t nodeCount = 0;
 
+/* every name of the module while NameNodes runs, a default name that would repeat one is moved along */
+static const char** nameSlots = NULL;
+static size_t nameSlotCount = 0;
+
+static bool parseFailed = false;
+static bool parsingInclude = false;
+static const char* currentPath = NULL;
+
+static IncludeEntry* includeCache = NULL;
+
+static IncludeSite* includeSites = NULL;
+static size_t includeSiteCount = 0;
+
+static char** dependencies = NULL;
+static size_t dependencyCount = 0;
+
+/* <Theme> elements are kept out of the view tree, their attributes are the resources */
+static TreeNode* themes = NULL;
+static TreeNode* lastTheme = NULL;
+
+/* Count of the <Repeat> being parsed, given to every node created inside it */
+static uint32_t repeatCount = 0;
+
+/* module being parsed, a UserControl is named after it and cannot reference itself */
+static const char* currentModule = NULL;
+
+/* document being traversed, xml strings point into it so their offsets give positions */
+static const uint8_t* documentStart = NULL;
+static size_t* lineStarts = NULL;
+static size_t lineCount = 0;
+static bool xmlErrorReported = false;
+
 /***************************************************************
 ** MARK: STATIC FUNCTION DEFS
 ***************************************************************/
 
 static void TraverseNode(struct xml_node* node, TreeNode* parent);
 static TreeNode* CreateNode(const char* className, const char* content, TreeNode* parent);
+static void AppendChild(TreeNode* parent, TreeNode* node);
 static void AddAttributeToNode(TreeNode* node, const char* key, const char* value);
-
-static void PrintNode(TreeNode* node, size_t depth);
+static bool ParseDefer(const char* value, uint32_t line, uint32_t column);
+static const char* CopyAttributeContent(struct xml_string* attributeContentObject);
+static char* CopyString(const char* string);
+static void NameNodes(TreeNode* rootNode);
+static void ReserveNames(const TreeNode* node);
+static void NameChildren(TreeNode* parent, uint32_t parentHash, bool atRoot);
+static char* DefaultInstanceName(const TreeNode* node, uint32_t index, uint32_t hash, bool atRoot);
+static bool ReserveName(const char* name);
+static uint32_t NameHash(uint32_t hash, const char* string);
+static void MarkRuntimeLinks(TreeNode* node);
+static void CheckNames(const TreeNode* scope);
+static void CheckScopeNames(const TreeNode* node, const TreeNode** slots, size_t slotCount);
+static void ReportRepeatedName(const TreeNode* node, const TreeNode* other);
+static const IncludeSite* FindIncludeSite(const TreeNode* node);
+
+static void SpliceInclude(struct xml_node* node, TreeNode* parent);
+static void ParseTheme(struct xml_node* node, TreeNode* parent);
+static void ParseItemTemplate(struct xml_node* node, TreeNode* parent);
+static void ParseRepeat(struct xml_node* node, TreeNode* parent);
+static void ParseUserControl(struct xml_node* node);
+static void ParseComponentClass(TreeNode* node, const char* value, uint32_t line, uint32_t column);
+static bool IsIdentifier(const char* value);
+static bool ParseItemsAttribute(TreeNode* list, const char* key, const char* value, uint32_t line, uint32_t column);
+static TreeNode* DetachLastChild(TreeNode* parent);
+static IncludeEntry* LoadInclude(const char* path, uint32_t line, uint32_t column);
+static TreeNode* CloneNode(const TreeNode* source, TreeNode* parent);
+static char* ResolveIncludePath(const char* includingPath, const char* source);
+static void NormalisePath(char* path);
+static void AddDependency(const char* path);
+
+static void BeginDocument(const uint8_t* buffer, size_t size);
+static void EndDocument(void);
+static void Locate(const void* position, uint32_t* line, uint32_t* column);
+static void ReportXmlError(size_t row, size_t column, const char* message);
+
+static void DumpNode(OutputBuffer* output, const TreeNode* node, size_t depth, const char* rootFile);
+static void DumpEscaped(OutputBuffer* output, const char* string);
 
 static void FreeNode(TreeNode* node);
 
@@ -59,16 +161,43 @@ static void FreeNode(TreeNode* node);
 ** MARK: PUBLIC FUNCTIONS
 ***************************************************************/
 
-TreeNode* ParseFile(char* contents, size_t size, const char* moduleName)
+TreeNode* ParseFile(char* contents, size_t size, const char* moduleName, const char* path)
 {
     nodeCount = 0;
+    rootNode = NULL;
+    parseFailed = false;
+    currentPath = path;
+    currentModule = moduleName;
+    repeatCount = 0;
+
+    for (size_t i = 0; i < dependencyCount; i++)
+    {
+        free(dependencies[i]);
+    }
+    free(dependencies);
+    dependencies = NULL;
+    dependencyCount = 0;
+
+    FreeNode(themes);
+    themes = NULL;
+    lastTheme = NULL;
+
+    xml_set_error_handler(ReportXmlError);
+    BeginDocument(contents, size);
 
     struct xml_document* document = xml_parse_document(contents, size);
 
     if (!document) 
     {
-        fprintf(stderr, "Error: Could not parse input file\n");
-        exit(1);
+        if (!xmlErrorReported)
+        {
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, path, 0, 0, "could not parse input file");
+        }
+
+        EndDocument();
+        xml_set_error_handler(NULL);
+        free(contents);
+        return NULL;
     }
 
     struct xml_node* root = xml_document_root(document);
@@ -80,9 +209,34 @@ TreeNode* ParseFile(char* contents, size_t size, const char* moduleName)
 
     xml_document_free(document, true);
 
-    /* print out tree */
+    EndDocument();
+    xml_set_error_handler(NULL);
+
+    /* checked once the tree is complete, an included name may repeat one declared after the <Include> */
+    if (rootNode && !parseFailed)
+    {
+        CheckNames(rootNode);
+        MarkRuntimeLinks(rootNode);
+    }
+
+    free(includeSites);
+    includeSites = NULL;
+    includeSiteCount = 0;
+
+    if (parseFailed)
+    {
+        FreeNode(rootNode);
+        FreeNode(themes);
+        rootNode = NULL;
+        themes = NULL;
+        lastTheme = NULL;
+        return NULL;
+    }
 
-    PrintNode(rootNode, 0);
+    if (rootNode)
+    {
+        NameNodes(rootNode);
+    }
 
     return rootNode;  
 }
@@ -93,6 +247,61 @@ void FreeFile(TreeNode* rootNode)
 
     FreeNode(rootNode);
     rootNode = NULL;
+
+    FreeNode(themes);
+    themes = NULL;
+    lastTheme = NULL;
+}
+
+char* DumpTree(const TreeNode* rootNode, size_t* size)
+{
+    OutputBuffer output;
+    BufferInit(&output, 4096);
+
+    if (rootNode)
+    {
+        DumpNode(&output, rootNode, 0, rootNode->file);
+    }
+
+    return BufferRelease(&output, size);
+}
+
+bool IsItemsClass(const char* className)
+{
+    return strcmp(className, "ListView") == 0 || strcmp(className, "ItemsControl") == 0;
+}
+
+const TreeNode* GetThemes(void)
+{
+    return themes;
+}
+
+size_t GetFileDependencies(const char* const** dependenciesOut)
+{
+    *dependenciesOut = (const char* const*)dependencies;
+    return dependencyCount;
+}
+
+void ClearIncludeCache(void)
+{
+    IncludeEntry* entry = includeCache;
+    while (entry)
+    {
+        IncludeEntry* nextEntry = entry->next;
+
+        FreeNode(entry->root);
+        for (size_t i = 0; i < entry->dependencyCount; i++)
+        {
+            free(entry->dependencies[i]);
+        }
+        free(entry->dependencies);
+        free(entry->path);
+        free(entry);
+
+        entry = nextEntry;
+    }
+
+    includeCache = NULL;
 }
 
 /***************************************************************
@@ -106,6 +315,42 @@ static void TraverseNode(struct xml_node* node, TreeNode* parent)
 
     const char* nodeClass = calloc(xml_string_length(xml_node_name(node)) + 1, 1);
     xml_string_copy(xml_node_name(node), nodeClass, xml_string_length(xml_node_name(node)));
+
+    if (strcmp(nodeClass, "Include") == 0)
+    {
+        free((void*)nodeClass);
+        SpliceInclude(node, parent);
+        return;
+    }
+
+    if (strcmp(nodeClass, "Theme") == 0)
+    {
+        free((void*)nodeClass);
+        ParseTheme(node, parent);
+        return;
+    }
+
+    if (strcmp(nodeClass, "ItemTemplate") == 0)
+    {
+        free((void*)nodeClass);
+        ParseItemTemplate(node, parent);
+        return;
+    }
+
+    if (strcmp(nodeClass, "Repeat") == 0)
+    {
+        free((void*)nodeClass);
+        ParseRepeat(node, parent);
+        return;
+    }
+
+    if (strcmp(nodeClass, "UserControl") == 0 && parent == NULL)
+    {
+        /* anywhere else it references a component, see ParseComponentClass */
+        free((void*)nodeClass);
+        ParseUserControl(node);
+        return;
+    }
     
     //for (int i = 0; i < depth; i++) printf("  ");
     //printf("Node: %s\n", nodeClass ? (char*)nodeClass : "(null)");
@@ -129,6 +374,14 @@ static void TraverseNode(struct xml_node* node, TreeNode* parent)
 
     TreeNode* newNode = CreateNode(nodeClass, nodeContent, parent);
 
+    /* the name follows the '<' of the opening tag */
+    Locate(xml_node_name(node)->buffer - 1, &newNode->line, &newNode->column);
+
+    if (nodeContent)
+    {
+        Locate(xml_node_content(node)->buffer, &newNode->properties->line, &newNode->properties->column);
+    }
+
     /* ATTRIBUTES */
 
     size_t attributesCount = xml_node_attributes(node);
@@ -141,23 +394,68 @@ static void TraverseNode(struct xml_node* node, TreeNode* parent)
         const char* attributeName = calloc(xml_string_length(attributeNameObject) + 1, 1);
         xml_string_copy(attributeNameObject, attributeName, xml_string_length(attributeNameObject));
 
-        /* code to handle items with spaces in between */
-        const char* attributeContentObjectString = attributeContentObject->buffer;
-        
-        size_t attributeContentLength = 0;
+        const char* attributeContent = CopyAttributeContent(attributeContentObject);
 
-        while (attributeContentObjectString[attributeContentLength] != '\0' && attributeContentObjectString[attributeContentLength] != '\"')
+        //for (int i = 0; i < depth; i++) printf("  ");
+        //printf("Attribute: %s = %s\n", attributeName, attributeContent);
+
+        if (strcmp(attributeName, "Defer") == 0)
         {
-            attributeContentLength++;
+            /* structural like Name, it never reaches the generated struct */
+            uint32_t line = 0;
+            uint32_t column = 0;
+            Locate(attributeNameObject->buffer, &line, &column);
+
+            if (parent == NULL && !parsingInclude)
+            {
+                DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "the root element cannot be deferred");
+                parseFailed = true;
+            }
+            else
+            {
+                newNode->deferred = ParseDefer(attributeContent, line, column);
+            }
+
+            free((void*)attributeName);
+            free((void*)attributeContent);
+            continue;
         }
 
-        const char* attributeContent = calloc(attributeContentLength + 1, 1);
-        sprintf(attributeContent, "%.*s", (int)attributeContentLength, attributeContentObjectString);
+        if (strcmp(newNode->className, "UserControl") == 0 && strcmp(attributeName, "Class") == 0)
+        {
+            /* names the component module, its struct becomes the member */
+            uint32_t line = 0;
+            uint32_t column = 0;
+            Locate(attributeNameObject->buffer, &line, &column);
 
-        //for (int i = 0; i < depth; i++) printf("  ");
-        //printf("Attribute: %s = %s\n", attributeName, attributeContent);
+            ParseComponentClass(newNode, attributeContent, line, column);
+
+            free((void*)attributeName);
+            continue;
+        }
+
+        if (newNode->items && (strcmp(attributeName, "PoolSize") == 0 || strcmp(attributeName, "ItemBound") == 0))
+        {
+            /* structural too, they shape the generated rows rather than a view field */
+            uint32_t line = 0;
+            uint32_t column = 0;
+            Locate(attributeNameObject->buffer, &line, &column);
+
+            if (!ParseItemsAttribute(newNode, attributeName, attributeContent, line, column))
+            {
+                free((void*)attributeContent);
+            }
+
+            free((void*)attributeName);
+            continue;
+        }
 
         AddAttributeToNode(newNode, attributeName, attributeContent);
+
+        if (newNode->lastProperty && newNode->lastProperty->value == attributeContent)
+        {
+            Locate(attributeNameObject->buffer, &newNode->lastProperty->line, &newNode->lastProperty->column);
+        }
     }
 
     /* Recurse into children */
@@ -168,6 +466,44 @@ static void TraverseNode(struct xml_node* node, TreeNode* parent)
         TraverseNode(child, newNode);
     }
 
+    if (strcmp(newNode->className, "UserControl") == 0)
+    {
+        /* the component is generated from its own file, a reference only places it */
+        if (newNode->child)
+        {
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, newNode->child->line, newNode->child->column, "a UserControl reference cannot have child elements, they belong in its own file");
+            parseFailed = true;
+        }
+
+        if (!newNode->component)
+        {
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, newNode->line, newNode->column, "UserControl requires a Class");
+            parseFailed = true;
+        }
+    }
+
+    if (newNode->items)
+    {
+        /* the generated rows own the list's children, ScrollTo links them */
+        if (newNode->child)
+        {
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, newNode->child->line, newNode->child->column, "children of %s belong in its ItemTemplate", newNode->className);
+            parseFailed = true;
+        }
+
+        if (!newNode->items->root)
+        {
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, newNode->line, newNode->column, "%s requires an ItemTemplate", newNode->className);
+            parseFailed = true;
+        }
+
+        if (!newNode->items->itemBound)
+        {
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, newNode->line, newNode->column, "%s requires an ItemBound callback", newNode->className);
+            parseFailed = true;
+        }
+    }
+
 }
 
 static TreeNode* CreateNode(const char* className, const char* content, TreeNode* parent)
@@ -175,70 +511,86 @@ static TreeNode* CreateNode(const char* className, const char* content, TreeNode
     TreeNode* newNode = (TreeNode*)malloc(sizeof(TreeNode));
     newNode->className = className;
     newNode->instanceName = NULL; /* from attribute Name */
+    newNode->named = false;
     newNode->properties = NULL; 
+    newNode->lastProperty = NULL;
     newNode->child = NULL;
+    newNode->lastChild = NULL;
     newNode->sibling = NULL;
     newNode->prevSibling = NULL;
+    newNode->origin = NULL;
+    newNode->deferred = false;
+    newNode->repeatCount = repeatCount;
+    newNode->repeatFirst = false;
+    newNode->runtimeLinks = false;
+    newNode->items = NULL;
+    newNode->component = NULL;
+    newNode->file = currentPath;
+    newNode->line = 0;
+    newNode->column = 0;
 
     newNode->parent = parent;
 
-    if (nodeCount == 0)
-    {
-        newNode->instanceName = "super"; /* root node */
-    }
-    else
+    /* the others are named by NameNodes once the whole tree is known */
+    if (parent == NULL && !parsingInclude)
     {
-        char* defaultInstanceName = (char*)malloc(strlen("child") + (sizeof(size_t) * 2) + 1);
-        sprintf(defaultInstanceName, "child%zu", nodeCount);
-        newNode->instanceName = defaultInstanceName;
+        newNode->instanceName = CopyString("super");
     }
 
-
     if (parent == NULL)
     {
         rootNode = newNode;
     }
     else
     {
-        /* add node to appropriate level */
-
-        if (parent->child == NULL)
-        {
-            parent->child = newNode;
-        }
-        else
-        {
-            TreeNode* sibling = parent->child;
-            while (sibling->sibling != NULL)
-            {
-                sibling = sibling->sibling;
-            }
-
-            sibling->sibling = newNode;
-            newNode->prevSibling = sibling;
-        }
-       
+        AppendChild(parent, newNode);
     }
 
     if (content)
     {
-        AddAttributeToNode(newNode, "Content", content);
+        AddAttributeToNode(newNode, CopyString("Content"), content);
     }
 
     //printf("Created node: %s %p\n", className, newNode);
 
+    if (IsItemsClass(className))
+    {
+        newNode->items = (ItemsTemplate*)calloc(1, sizeof(ItemsTemplate));
+        newNode->items->poolSize = ITEMS_DEFAULT_POOL_SIZE;
+    }
+
     nodeCount++;
 
     return newNode;
 }
 
+static void AppendChild(TreeNode* parent, TreeNode* node)
+{
+    /* add node to appropriate level */
+
+    if (parent->child == NULL)
+    {
+        parent->child = node;
+    }
+    else
+    {
+        parent->lastChild->sibling = node;
+        node->prevSibling = parent->lastChild;
+    }
+
+    parent->lastChild = node;
+}
+
 static void AddAttributeToNode(TreeNode* node, const char* key, const char* value)
 {
     if (!node || !key || !value) return;
 
     if (strcmp(key, "Name") == 0)
     {
+        free((void*)node->instanceName);
+        free((void*)key);
         node->instanceName = value;
+        node->named = true;
     }
     else
     {
@@ -246,6 +598,8 @@ static void AddAttributeToNode(TreeNode* node, const char* key, const char* valu
         newProperty->key = key;
         newProperty->value = value;
         newProperty->next = NULL;
+        newProperty->line = 0;
+        newProperty->column = 0;
 
         if (!node->properties)
         {
@@ -253,70 +607,1296 @@ static void AddAttributeToNode(TreeNode* node, const char* key, const char* valu
         }
         else 
         {
-            NodeProperty* current = node->properties;
-            while (current->next != NULL)
+            node->lastProperty->next = newProperty;
+        }
+
+        node->lastProperty = newProperty;
+
+        //printf("Added property: %s = %s to class %s\n", key, value, node->className);
+    }
+}
+
+static bool ParseDefer(const char* value, uint32_t line, uint32_t column)
+{
+    if (strcmp(value, "True") == 0 || strcmp(value, "true") == 0)
+    {
+        return true;
+    }
+
+    if (strcmp(value, "False") != 0 && strcmp(value, "false") != 0)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "Defer expects True or False, got '%s'", value);
+        parseFailed = true;
+    }
+
+    return false;
+}
+
+static const char* CopyAttributeContent(struct xml_string* attributeContentObject)
+{
+    /* code to handle items with spaces in between */
+    const char* attributeContentObjectString = attributeContentObject->buffer;
+    
+    size_t attributeContentLength = 0;
+
+    while (attributeContentObjectString[attributeContentLength] != '\0' && attributeContentObjectString[attributeContentLength] != '\"')
+    {
+        attributeContentLength++;
+    }
+
+    char* attributeContent = calloc(attributeContentLength + 1, 1);
+    sprintf(attributeContent, "%.*s", (int)attributeContentLength, attributeContentObjectString);
+
+    return attributeContent;
+}
+
+static char* CopyString(const char* string)
+{
+    char* copy = (char*)malloc(strlen(string) + 1);
+    strcpy(copy, string);
+    return copy;
+}
+
+static void NameNodes(TreeNode* rootNode)
+{
+    /* names come from the path rather than the parse order, an edit only renames the elements it moved */
+    nameSlotCount = 64;
+
+    while (nameSlotCount < nodeCount * 2)
+    {
+        nameSlotCount *= 2;
+    }
+
+    nameSlots = (const char**)calloc(nameSlotCount, sizeof(const char*));
+
+    if (!nameSlots)
+    {
+        nameSlotCount = 0;
+    }
+
+    ReserveNames(rootNode);
+    NameChildren(rootNode, NameHash(2166136261u, rootNode->instanceName), true);
+
+    free(nameSlots);
+    nameSlots = NULL;
+    nameSlotCount = 0;
+}
+
+static void ReserveNames(const TreeNode* node)
+{
+    for (; node != NULL; node = node->sibling)
+    {
+        if (node->instanceName)
+        {
+            ReserveName(node->instanceName);
+        }
+
+        if (node->items && node->items->root)
+        {
+            ReserveNames(node->items->root);
+        }
+
+        ReserveNames(node->child);
+    }
+}
+
+static void NameChildren(TreeNode* parent, uint32_t parentHash, bool atRoot)
+{
+    /* index among the earlier siblings of the same class, a handful of classes per parent at most */
+    const char** classes = NULL;
+    uint32_t* classCounts = NULL;
+    size_t classCount = 0;
+
+    TreeNode* child = parent->child;
+    TreeNode* itemRoot = (parent->items) ? parent->items->root : NULL;
+
+    while (child || itemRoot)
+    {
+        /* the item template is a row of its own, named as if it were the list's only child */
+        TreeNode* node = child ? child : itemRoot;
+        uint32_t index = 0;
+
+        if (child)
+        {
+            size_t i = 0;
+
+            while (i < classCount && strcmp(classes[i], node->className) != 0)
+            {
+                i++;
+            }
+
+            if (i == classCount)
+            {
+                const char** grownClasses = (const char**)realloc(classes, (classCount + 1) * sizeof(const char*));
+                uint32_t* grownCounts = grownClasses ? (uint32_t*)realloc(classCounts, (classCount + 1) * sizeof(uint32_t)) : NULL;
+
+                if (grownClasses) classes = grownClasses;
+                if (grownCounts) classCounts = grownCounts;
+
+                /* without the count the index stays 0, ReserveName still keeps the names apart */
+                if (grownClasses && grownCounts)
+                {
+                    classes[classCount] = node->className;
+                    classCounts[classCount] = 0;
+                    classCount++;
+                }
+            }
+
+            if (i < classCount)
             {
-                current = current->next;
+                index = classCounts[i]++;
             }
+        }
 
-            current->next = newProperty;
+        uint32_t hash = NameHash(parentHash, node->className);
+        hash = (hash ^ index) * 16777619u;
+
+        if (node->instanceName)
+        {
+            /* a Name anchors its subtree, renumbering above it leaves the names below alone */
+            hash = NameHash(2166136261u, node->instanceName);
+        }
+        else
+        {
+            node->instanceName = DefaultInstanceName(node, index, hash, atRoot);
         }
 
-        //printf("Added property: %s = %s to class %s\n", key, value, node->className);
+        NameChildren(node, hash, false);
+
+        if (child)
+        {
+            child = child->sibling;
+        }
+        else
+        {
+            itemRoot = NULL;
+        }
     }
+
+    free(classes);
+    free(classCounts);
 }
 
-static void PrintNode(TreeNode* node, size_t depth)
+static char* DefaultInstanceName(const TreeNode* node, uint32_t index, uint32_t hash, bool atRoot)
 {
-    if (!node) return;
+    /* class and index read well directly below the root, deeper down a short hash of the path keeps them apart */
+    size_t size = strlen(node->className) + (sizeof(uint32_t) * 3) + NAME_HASH_DIGITS + 2;
+    char* name = (char*)malloc(size);
 
-    for (size_t i = 0; i < depth; i++) printf("  ");
-    printf("Node: %s\n", node->className ? node->className : "(null)");
+    snprintf(name, size, "%s%u", node->className, (unsigned)index);
+    name[0] = (char)tolower((unsigned char)name[0]);
 
-    if (node->instanceName)
+    if (atRoot && ReserveName(name))
     {
-        for (size_t i = 0; i < depth + 1; i++) printf("  ");
-        printf("Instance Name: %s\n", node->instanceName);
+        return name;
     }
 
-    NodeProperty* property = node->properties;
-    while (property)
+    size_t baseLength = strlen(name);
+
+    do
     {
-        for (size_t i = 0; i < depth + 1; i++) printf("  ");
-        printf("Property: %s = %s\n", property->key, property->value);
-        property = property->next;
+        snprintf(name + baseLength, size - baseLength, "_%0*x", NAME_HASH_DIGITS, (unsigned)(hash & ((1u << (NAME_HASH_DIGITS * 4)) - 1)));
+        hash = (hash ^ 1u) * 16777619u;
     }
+    while (!ReserveName(name));
 
-    if (node->child)
+    return name;
+}
+
+static bool ReserveName(const char* name)
+{
+    /* false if the name is taken, without a table every name is taken to be free */
+    if (nameSlotCount == 0) return true;
+
+    size_t slot = NameHash(2166136261u, name) & (nameSlotCount - 1);
+
+    for (; nameSlots[slot] != NULL; slot = (slot + 1) & (nameSlotCount - 1))
     {
-        PrintNode(node->child, depth + 1);
+        if (strcmp(nameSlots[slot], name) == 0) return false;
     }
 
-    if (node->sibling)
+    nameSlots[slot] = name;
+    return true;
+}
+
+static uint32_t NameHash(uint32_t hash, const char* string)
+{
+    for (; *string != '\0'; string++)
     {
-        PrintNode(node->sibling, depth);
+        hash ^= (uint8_t)*string;
+        hash *= 16777619u;
     }
 
+    return hash;
 }
 
-static void FreeNode(TreeNode* node)
+static void MarkRuntimeLinks(TreeNode* node)
 {
-    if (!node) return;
-    
-    if (node->className) free((void*)node->className);
-    if (node->instanceName) free((void*)node->instanceName);
+    /* one pass over the finished tree, the emitters ask for every node and would otherwise walk its siblings each time */
+    for (; node != NULL; node = node->sibling)
+    {
+        for (const TreeNode* child = node->child; child != NULL && !node->runtimeLinks; child = child->sibling)
+        {
+            node->runtimeLinks = child->repeatFirst || child->component;
+        }
+
+        if (node->items && node->items->root)
+        {
+            MarkRuntimeLinks(node->items->root);
+        }
 
-    NodeProperty* property = node->properties;
-    while (property)
+        MarkRuntimeLinks(node->child);
+    }
+}
+
+static void CheckNames(const TreeNode* scope)
+{
+    /* the explicit names of one struct, the module or a list row, a repeated one would declare its member twice */
+    size_t slotCount = 64;
+
+    while (slotCount < nodeCount * 2)
     {
-        NodeProperty* nextProperty = property->next;
-        free((void*)property->key);
-        free((void*)property->value);
-        free(property);
-        property = nextProperty;
+        slotCount *= 2;
     }
 
-    if (node->child) FreeNode(node->child);
-    if (node->sibling) FreeNode(node->sibling);
-    free(node);
-}
\ No newline at end of file
+    const TreeNode** slots = (const TreeNode**)calloc(slotCount, sizeof(const TreeNode*));
+
+    if (!slots) return;
+
+    CheckScopeNames(scope, slots, slotCount);
+
+    free(slots);
+}
+
+static void CheckScopeNames(const TreeNode* node, const TreeNode** slots, size_t slotCount)
+{
+    for (; node != NULL; node = node->sibling)
+    {
+        if (node->named && node->instanceName)
+        {
+            size_t slot = NameHash(2166136261u, node->instanceName) & (slotCount - 1);
+
+            while (slots[slot] != NULL && strcmp(slots[slot]->instanceName, node->instanceName) != 0)
+            {
+                slot = (slot + 1) & (slotCount - 1);
+            }
+
+            const TreeNode* other = slots[slot];
+
+            if (other == NULL)
+            {
+                slots[slot] = node;
+            }
+            else
+            {
+                ReportRepeatedName(node, other);
+            }
+        }
+
+        /* a row template is a struct of its own */
+        if (node->items && node->items->root)
+        {
+            CheckNames(node->items->root);
+        }
+
+        CheckScopeNames(node->child, slots, slotCount);
+    }
+}
+
+static void ReportRepeatedName(const TreeNode* node, const TreeNode* other)
+{
+    /* kept out of CheckScopeNames, its frame is on the stack once per level of a deep tree */
+    const char* otherFile = (other->file && (!node->file || strcmp(other->file, node->file) != 0)) ? other->file : NULL;
+    const IncludeSite* site = FindIncludeSite(node);
+    char where[512] = "";
+
+    if (site)
+    {
+        snprintf(where, sizeof(where), ", included at %s%s%u:%u", site->file ? site->file : "", site->file ? ":" : "", (unsigned)site->line, (unsigned)site->column);
+    }
+
+    /* the first use is only given its file when it is in another one */
+    DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, node->line, node->column, "Name '%s' is already used at %s%s%u:%u%s",
+        node->instanceName,
+        otherFile ? otherFile : "",
+        otherFile ? ":" : "",
+        (unsigned)other->line,
+        (unsigned)other->column,
+        where
+    );
+
+    parseFailed = true;
+}
+
+static const IncludeSite* FindIncludeSite(const TreeNode* node)
+{
+    /* only walked for a repeated name, the outermost spliced ancestor is the one with a site */
+    const IncludeSite* found = NULL;
+
+    for (; node != NULL && node->origin != NULL; node = node->parent)
+    {
+        for (size_t i = 0; i < includeSiteCount; i++)
+        {
+            if (includeSites[i].root == node) found = &includeSites[i];
+        }
+    }
+
+    return found;
+}
+
+static void SpliceInclude(struct xml_node* node, TreeNode* parent)
+{
+    uint32_t line = 0;
+    uint32_t column = 0;
+    Locate(xml_node_name(node)->buffer - 1, &line, &column);
+
+    if (parent == NULL)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "Include cannot be the root element");
+        parseFailed = true;
+        return;
+    }
+
+    const char* source = NULL;
+    bool deferred = false;
+
+    size_t attributesCount = xml_node_attributes(node);
+
+    for (size_t i = 0; i < attributesCount; i++)
+    {
+        struct xml_string* attributeNameObject = xml_node_attribute_name(node, i);
+
+        char* attributeName = calloc(xml_string_length(attributeNameObject) + 1, 1);
+        xml_string_copy(attributeNameObject, (uint8_t*)attributeName, xml_string_length(attributeNameObject));
+
+        if (strcmp(attributeName, "Source") == 0)
+        {
+            free((void*)source);
+            source = CopyAttributeContent(xml_node_attribute_content(node, i));
+        }
+        else if (strcmp(attributeName, "Defer") == 0)
+        {
+            uint32_t attributeLine = 0;
+            uint32_t attributeColumn = 0;
+            Locate(attributeNameObject->buffer, &attributeLine, &attributeColumn);
+
+            const char* value = CopyAttributeContent(xml_node_attribute_content(node, i));
+            deferred = ParseDefer(value, attributeLine, attributeColumn);
+            free((void*)value);
+        }
+        else
+        {
+            uint32_t attributeLine = 0;
+            uint32_t attributeColumn = 0;
+            Locate(attributeNameObject->buffer, &attributeLine, &attributeColumn);
+
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, attributeLine, attributeColumn, "unknown property '%s' for class 'Include'", attributeName);
+            parseFailed = true;
+        }
+
+        free(attributeName);
+    }
+
+    if (!source || strlen(source) == 0)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "Include requires a Source");
+        parseFailed = true;
+        free((void*)source);
+        return;
+    }
+
+    char* path = ResolveIncludePath(currentPath, source);
+    free((void*)source);
+
+    IncludeEntry* entry = LoadInclude(path, line, column);
+    free(path);
+
+    if (!entry || !entry->root)
+    {
+        parseFailed = true;
+        return;
+    }
+
+    AddDependency(entry->path);
+    for (size_t i = 0; i < entry->dependencyCount; i++)
+    {
+        AddDependency(entry->dependencies[i]);
+    }
+
+    TreeNode* included = CloneNode(entry->root, parent);
+
+    if (deferred)
+    {
+        included->deferred = true;
+    }
+
+    /* an <Include> inside an included file is part of the cached tree, the outermost site is the one reported */
+    if (!parsingInclude)
+    {
+        IncludeSite* grown = (IncludeSite*)realloc(includeSites, (includeSiteCount + 1) * sizeof(IncludeSite));
+
+        if (grown)
+        {
+            includeSites = grown;
+            includeSites[includeSiteCount++] = (IncludeSite){ included, currentPath, line, column };
+        }
+    }
+}
+
+static void ParseTheme(struct xml_node* node, TreeNode* parent)
+{
+    uint32_t line = 0;
+    uint32_t column = 0;
+    Locate(xml_node_name(node)->buffer - 1, &line, &column);
+
+    if (parent == NULL || parent->parent != NULL || parsingInclude || repeatCount > 0)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "Theme can only be a child of the module root element");
+        parseFailed = true;
+        return;
+    }
+
+    if (xml_node_children(node) > 0)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "Theme cannot have child elements");
+        parseFailed = true;
+        return;
+    }
+
+    /* built by hand, CreateNode would add it to the view tree */
+    TreeNode* theme = (TreeNode*)calloc(1, sizeof(TreeNode));
+    theme->className = CopyString("Theme");
+    theme->file = currentPath;
+    theme->line = line;
+    theme->column = column;
+
+    size_t attributesCount = xml_node_attributes(node);
+
+    for (size_t i = 0; i < attributesCount; i++)
+    {
+        struct xml_string* attributeNameObject = xml_node_attribute_name(node, i);
+
+        char* attributeName = calloc(xml_string_length(attributeNameObject) + 1, 1);
+        xml_string_copy(attributeNameObject, (uint8_t*)attributeName, xml_string_length(attributeNameObject));
+
+        AddAttributeToNode(theme, attributeName, CopyAttributeContent(xml_node_attribute_content(node, i)));
+
+        if (theme->lastProperty && theme->lastProperty->key == attributeName)
+        {
+            Locate(attributeNameObject->buffer, &theme->lastProperty->line, &theme->lastProperty->column);
+        }
+    }
+
+    if (!theme->instanceName)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "Theme requires a Name");
+        parseFailed = true;
+    }
+
+    if (lastTheme)
+    {
+        lastTheme->sibling = theme;
+        theme->prevSibling = lastTheme;
+    }
+    else
+    {
+        themes = theme;
+    }
+
+    lastTheme = theme;
+}
+
+static void ParseItemTemplate(struct xml_node* node, TreeNode* parent)
+{
+    uint32_t line = 0;
+    uint32_t column = 0;
+    Locate(xml_node_name(node)->buffer - 1, &line, &column);
+
+    if (parent == NULL || !parent->items)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "ItemTemplate can only be a child of ListView or ItemsControl");
+        parseFailed = true;
+        return;
+    }
+
+    if (parent->items->root)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "%s already has an ItemTemplate", parent->className);
+        parseFailed = true;
+        return;
+    }
+
+    if (xml_node_attributes(node) > 0 || xml_node_children(node) != 1)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "ItemTemplate takes no attributes and exactly one element");
+        parseFailed = true;
+        return;
+    }
+
+    /* parsed as a child of the list, then moved out of its child list */
+    TreeNode* lastChild = parent->lastChild;
+    TraverseNode(xml_node_child(node, 0), parent);
+
+    if (parent->lastChild != lastChild)
+    {
+        parent->items->root = DetachLastChild(parent);
+    }
+}
+
+static void ParseRepeat(struct xml_node* node, TreeNode* parent)
+{
+    uint32_t line = 0;
+    uint32_t column = 0;
+    Locate(xml_node_name(node)->buffer - 1, &line, &column);
+
+    if (parent == NULL)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "Repeat cannot be the root element");
+        parseFailed = true;
+        return;
+    }
+
+    if (repeatCount > 0)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "Repeat cannot be nested");
+        parseFailed = true;
+        return;
+    }
+
+    if (strcmp(parent->className, "Window") == 0 || parent->items)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "Repeat cannot be a child of %s", parent->className);
+        parseFailed = true;
+        return;
+    }
+
+    unsigned long count = 0;
+    bool hasCount = false;
+    size_t attributesCount = xml_node_attributes(node);
+
+    for (size_t i = 0; i < attributesCount; i++)
+    {
+        struct xml_string* attributeNameObject = xml_node_attribute_name(node, i);
+
+        char* attributeName = calloc(xml_string_length(attributeNameObject) + 1, 1);
+        xml_string_copy(attributeNameObject, (uint8_t*)attributeName, xml_string_length(attributeNameObject));
+
+        uint32_t attributeLine = 0;
+        uint32_t attributeColumn = 0;
+        Locate(attributeNameObject->buffer, &attributeLine, &attributeColumn);
+
+        if (strcmp(attributeName, "Count") == 0)
+        {
+            const char* value = CopyAttributeContent(xml_node_attribute_content(node, i));
+
+            char* end = NULL;
+            count = strtoul(value, &end, 10);
+            hasCount = true;
+
+            if (end == value || *end != '\0' || count == 0 || count > REPEAT_MAX_COUNT)
+            {
+                DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, attributeLine, attributeColumn, "Count expects a repeat count from 1 to %d, got '%s'", REPEAT_MAX_COUNT, value);
+                parseFailed = true;
+                count = 0;
+            }
+
+            free((void*)value);
+        }
+        else
+        {
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, attributeLine, attributeColumn, "unknown property '%s' for class 'Repeat'", attributeName);
+            parseFailed = true;
+        }
+
+        free(attributeName);
+    }
+
+    if (!hasCount)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "Repeat requires a Count");
+        parseFailed = true;
+        return;
+    }
+
+    if (count == 0) return; /* reported against the attribute */
+
+    if (xml_node_children(node) == 0)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "Repeat requires at least one element");
+        parseFailed = true;
+        return;
+    }
+
+    /* the elements are spliced into the parent, each becomes a member array filled by one loop */
+    TreeNode* lastChild = parent->lastChild;
+
+    repeatCount = (uint32_t)count;
+
+    for (size_t i = 0; i < xml_node_children(node); i++)
+    {
+        TraverseNode(xml_node_child(node, i), parent);
+    }
+
+    repeatCount = 0;
+
+    TreeNode* first = lastChild ? lastChild->sibling : parent->child;
+
+    if (first)
+    {
+        first->repeatFirst = true;
+    }
+}
+
+static void ParseUserControl(struct xml_node* node)
+{
+    uint32_t line = 0;
+    uint32_t column = 0;
+    Locate(xml_node_name(node)->buffer - 1, &line, &column);
+
+    if (parsingInclude)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "a UserControl cannot be included, reference it with <UserControl Class=\"...\"/>");
+        parseFailed = true;
+        return;
+    }
+
+    const char* className = NULL;
+    size_t attributesCount = xml_node_attributes(node);
+
+    for (size_t i = 0; i < attributesCount; i++)
+    {
+        struct xml_string* attributeNameObject = xml_node_attribute_name(node, i);
+
+        char* attributeName = calloc(xml_string_length(attributeNameObject) + 1, 1);
+        xml_string_copy(attributeNameObject, (uint8_t*)attributeName, xml_string_length(attributeNameObject));
+
+        uint32_t attributeLine = 0;
+        uint32_t attributeColumn = 0;
+        Locate(attributeNameObject->buffer, &attributeLine, &attributeColumn);
+
+        if (strcmp(attributeName, "Class") == 0)
+        {
+            free((void*)className);
+            className = CopyAttributeContent(xml_node_attribute_content(node, i));
+
+            /* the generated names come from the module, the Class only confirms which one this file is */
+            if (!currentModule || strcmp(className, currentModule) != 0)
+            {
+                DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, attributeLine, attributeColumn, "UserControl Class '%s' does not match the module name '%s'", className, currentModule ? currentModule : "");
+                parseFailed = true;
+            }
+        }
+        else
+        {
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, attributeLine, attributeColumn, "unknown property '%s' for class 'UserControl'", attributeName);
+            parseFailed = true;
+        }
+
+        free(attributeName);
+    }
+
+    if (!className)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "UserControl requires a Class");
+        parseFailed = true;
+    }
+
+    free((void*)className);
+
+    if (xml_node_children(node) != 1)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "UserControl takes exactly one element");
+        parseFailed = true;
+        return;
+    }
+
+    /* the single element is the module root, so the component is an ordinary module with a view as its super */
+    TraverseNode(xml_node_child(node, 0), NULL);
+
+    if (!rootNode) return;
+
+    if (strcmp(rootNode->className, "Window") == 0 || strcmp(rootNode->className, "UserControl") == 0)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, rootNode->line, rootNode->column, "the element of a UserControl cannot be a %s", rootNode->className);
+        parseFailed = true;
+    }
+    else if (strcmp(rootNode->instanceName, "super") != 0)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, rootNode->line, rootNode->column, "the element of a UserControl is its super member and cannot be named");
+        parseFailed = true;
+    }
+}
+
+static void ParseComponentClass(TreeNode* node, const char* value, uint32_t line, uint32_t column)
+{
+    if (!IsIdentifier(value))
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "Class expects the module name of a UserControl, got '%s'", value);
+        parseFailed = true;
+    }
+    else if (!parsingInclude && currentModule && strcmp(value, currentModule) == 0)
+    {
+        /* an include is checked when spliced, its cached tree may serve other modules */
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "UserControl '%s' cannot reference itself", value);
+        parseFailed = true;
+    }
+
+    /* kept even when rejected, the node owns it and is not reported again as missing a Class */
+    free((void*)node->component);
+    node->component = value;
+}
+
+static bool IsIdentifier(const char* value)
+{
+    if (!isalpha((unsigned char)value[0]) && value[0] != '_') return false;
+
+    for (size_t i = 1; value[i] != '\0'; i++)
+    {
+        if (!isalnum((unsigned char)value[i]) && value[i] != '_') return false;
+    }
+
+    return true;
+}
+
+static bool ParseItemsAttribute(TreeNode* list, const char* key, const char* value, uint32_t line, uint32_t column)
+{
+    if (strcmp(key, "ItemBound") == 0)
+    {
+        free((void*)list->items->itemBound);
+        list->items->itemBound = value;
+        return true;
+    }
+
+    char* end = NULL;
+    unsigned long poolSize = strtoul(value, &end, 10);
+
+    if (end == value || *end != '\0' || poolSize == 0 || poolSize > ITEMS_MAX_POOL_SIZE)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "PoolSize expects a row count from 1 to %d, got '%s'", ITEMS_MAX_POOL_SIZE, value);
+        parseFailed = true;
+    }
+    else
+    {
+        list->items->poolSize = (uint32_t)poolSize;
+    }
+
+    return false;
+}
+
+static TreeNode* DetachLastChild(TreeNode* parent)
+{
+    TreeNode* node = parent->lastChild;
+
+    parent->lastChild = node->prevSibling;
+
+    if (node->prevSibling)
+    {
+        node->prevSibling->sibling = NULL;
+    }
+    else
+    {
+        parent->child = NULL;
+    }
+
+    node->prevSibling = NULL;
+
+    return node;
+}
+
+static IncludeEntry* LoadInclude(const char* path, uint32_t line, uint32_t column)
+{
+    for (IncludeEntry* entry = includeCache; entry != NULL; entry = entry->next)
+    {
+        if (strcmp(entry->path, path) == 0)
+        {
+            if (entry->loading)
+            {
+                DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "include cycle through '%s'", path);
+                return NULL;
+            }
+
+            if (!entry->root)
+            {
+                /* its errors were reported when it was first loaded, maybe for another module */
+                DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "include file '%s' failed to parse", path);
+            }
+
+            return entry;
+        }
+    }
+
+    IncludeEntry* entry = (IncludeEntry*)calloc(1, sizeof(IncludeEntry));
+    entry->path = CopyString(path);
+    entry->loading = true;
+    entry->next = includeCache;
+    includeCache = entry;
+
+    FILE* includeFile = fopen(path, "rb");
+
+    if (!includeFile)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, line, column, "could not open include file '%s'", path);
+        entry->loading = false;
+        return entry;
+    }
+
+    fseek(includeFile, 0, SEEK_END);
+    size_t fileSize = ftell(includeFile);
+    fseek(includeFile, 0, SEEK_SET);
+
+    uint8_t* fileBuffer = (uint8_t*)malloc(fileSize + 1);
+    fileSize = fread(fileBuffer, 1, fileSize, includeFile);
+    fileBuffer[fileSize] = '\0';
+    fclose(includeFile);
+
+    /* parse with module state saved, the include tree is built on its own */
+    TreeNode* savedRootNode = rootNode;
+    size_t savedNodeCount = nodeCount;
+    bool savedParsingInclude = parsingInclude;
+    const char* savedCurrentPath = currentPath;
+    char** savedDependencies = dependencies;
+    size_t savedDependencyCount = dependencyCount;
+    const uint8_t* savedDocumentStart = documentStart;
+    size_t* savedLineStarts = lineStarts;
+    size_t savedLineCount = lineCount;
+    bool savedXmlErrorReported = xmlErrorReported;
+    uint32_t savedRepeatCount = repeatCount;
+    bool savedParseFailed = parseFailed;
+
+    rootNode = NULL;
+    parseFailed = false;
+    parsingInclude = true;
+    repeatCount = 0;
+    currentPath = entry->path;
+    dependencies = NULL;
+    dependencyCount = 0;
+
+    BeginDocument(fileBuffer, fileSize);
+
+    struct xml_document* document = xml_parse_document(fileBuffer, fileSize);
+
+    if (document)
+    {
+        TraverseNode(xml_document_root(document), NULL);
+        xml_document_free(document, true);
+    }
+    else
+    {
+        if (!xmlErrorReported)
+        {
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, entry->path, 0, 0, "could not parse include file");
+        }
+
+        free(fileBuffer);
+    }
+
+    EndDocument();
+
+    if (rootNode && strcmp(rootNode->className, "Window") == 0)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, rootNode->file, rootNode->line, rootNode->column, "included file cannot have a Window root");
+        parseFailed = true;
+    }
+
+    if (parseFailed)
+    {
+        /* a partial tree is never cached, every later splice sees the failure */
+        FreeNode(rootNode);
+        rootNode = NULL;
+    }
+
+    entry->root = rootNode;
+    entry->dependencies = dependencies;
+    entry->dependencyCount = dependencyCount;
+
+    rootNode = savedRootNode;
+    nodeCount = savedNodeCount;
+    parsingInclude = savedParsingInclude;
+    currentPath = savedCurrentPath;
+    dependencies = savedDependencies;
+    dependencyCount = savedDependencyCount;
+    documentStart = savedDocumentStart;
+    lineStarts = savedLineStarts;
+    lineCount = savedLineCount;
+    xmlErrorReported = savedXmlErrorReported;
+    repeatCount = savedRepeatCount;
+    parseFailed = savedParseFailed;
+
+    entry->loading = false;
+
+    return entry;
+}
+
+static TreeNode* CloneNode(const TreeNode* source, TreeNode* parent)
+{
+    /* the cached tree stays untouched, the clone borrows its strings and properties */
+    TreeNode* newNode = (TreeNode*)malloc(sizeof(TreeNode));
+    newNode->className = source->className;
+    newNode->instanceName = source->instanceName;
+    newNode->named = source->named;
+    newNode->properties = source->properties;
+    newNode->lastProperty = source->lastProperty;
+    newNode->child = NULL;
+    newNode->lastChild = NULL;
+    newNode->sibling = NULL;
+    newNode->prevSibling = NULL;
+    newNode->origin = source;
+    newNode->deferred = source->deferred;
+    newNode->repeatCount = repeatCount ? repeatCount : source->repeatCount;
+    newNode->repeatFirst = source->repeatFirst;
+    newNode->runtimeLinks = false;
+    newNode->component = source->component;
+    newNode->file = source->file;
+    newNode->line = source->line;
+    newNode->column = source->column;
+
+    newNode->parent = parent;
+
+    if (repeatCount && source->repeatCount && source->repeatFirst)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, source->file, source->line, source->column, "Repeat cannot be nested");
+        parseFailed = true;
+    }
+
+    if (source->component && currentModule && strcmp(source->component, currentModule) == 0)
+    {
+        /* the cached include may have been parsed for another module */
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, source->file, source->line, source->column, "UserControl '%s' cannot reference itself", source->component);
+        parseFailed = true;
+    }
+
+    AppendChild(parent, newNode);
+
+    nodeCount++;
+
+    newNode->items = NULL;
+
+    if (source->items)
+    {
+        /* the callback name is borrowed like the properties */
+        newNode->items = (ItemsTemplate*)malloc(sizeof(ItemsTemplate));
+        *newNode->items = *source->items;
+
+        newNode->items->root = NULL;
+
+        if (source->items->root)
+        {
+            CloneNode(source->items->root, newNode);
+            newNode->items->root = DetachLastChild(newNode);
+        }
+    }
+
+    for (TreeNode* childNode = source->child; childNode != NULL; childNode = childNode->sibling)
+    {
+        CloneNode(childNode, newNode);
+    }
+
+    return newNode;
+}
+
+static char* ResolveIncludePath(const char* includingPath, const char* source)
+{
+    size_t directoryLength = 0;
+
+    bool isAbsolute = source[0] == '/' || source[0] == '\\' || (isalpha((unsigned char)source[0]) && source[1] == ':');
+
+    if (includingPath && !isAbsolute)
+    {
+        /* relative to the directory of the including file */
+        for (size_t i = 0; includingPath[i] != '\0'; i++)
+        {
+            if (includingPath[i] == '/' || includingPath[i] == '\\')
+            {
+                directoryLength = i + 1;
+            }
+        }
+    }
+
+    char* path = (char*)malloc(directoryLength + strlen(source) + 1);
+    memcpy(path, includingPath, directoryLength);
+    strcpy(path + directoryLength, source);
+
+    NormalisePath(path);
+
+    return path;
+}
+
+static void NormalisePath(char* path)
+{
+    /* collapse "." and "dir/.." so one file always maps to one cache entry */
+    size_t rootLength = 0;
+
+    if (path[0] == '/' || path[0] == '\\')
+    {
+        rootLength = 1;
+    }
+    else if (isalpha((unsigned char)path[0]) && path[1] == ':')
+    {
+        rootLength = (path[2] == '/' || path[2] == '\\') ? 3 : 2;
+    }
+
+    size_t read = rootLength;
+    size_t write = rootLength;
+
+    while (path[read] != '\0')
+    {
+        size_t end = read;
+        while (path[end] != '\0' && path[end] != '/' && path[end] != '\\')
+        {
+            end++;
+        }
+
+        size_t segmentLength = end - read;
+        bool isParent = segmentLength == 2 && path[read] == '.' && path[read + 1] == '.';
+
+        size_t previous = write;
+        while (previous > rootLength && path[previous - 1] != '/')
+        {
+            previous--;
+        }
+        bool previousIsParent = (write - previous) == 2 && path[previous] == '.' && path[previous + 1] == '.';
+
+        if (segmentLength == 0 || (segmentLength == 1 && path[read] == '.'))
+        {
+            /* skip empty and current directory segments */
+        }
+        else if (isParent && write > rootLength && !previousIsParent)
+        {
+            write = (previous > rootLength) ? previous - 1 : rootLength;
+        }
+        else if (isParent && rootLength > 0)
+        {
+            /* cannot go above the root */
+        }
+        else
+        {
+            if (write > rootLength)
+            {
+                path[write++] = '/';
+            }
+
+            memmove(path + write, path + read, segmentLength);
+            write += segmentLength;
+        }
+
+        read = (path[end] != '\0') ? end + 1 : end;
+    }
+
+    path[write] = '\0';
+}
+
+static void AddDependency(const char* path)
+{
+    for (size_t i = 0; i < dependencyCount; i++)
+    {
+        if (strcmp(dependencies[i], path) == 0) return;
+    }
+
+    dependencies = (char**)realloc(dependencies, (dependencyCount + 1) * sizeof(char*));
+    dependencies[dependencyCount++] = CopyString(path);
+}
+
+static void BeginDocument(const uint8_t* buffer, size_t size)
+{
+    /* line starts are found once, positions are then a binary search away */
+    documentStart = buffer;
+    xmlErrorReported = false;
+
+    lineCount = 1;
+    for (size_t i = 0; i < size; i++)
+    {
+        if (buffer[i] == '\n') lineCount++;
+    }
+
+    lineStarts = (size_t*)malloc(lineCount * sizeof(size_t));
+
+    size_t line = 0;
+    lineStarts[line++] = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        if (buffer[i] == '\n') lineStarts[line++] = i + 1;
+    }
+}
+
+static void EndDocument(void)
+{
+    free(lineStarts);
+    lineStarts = NULL;
+    lineCount = 0;
+    documentStart = NULL;
+}
+
+static void Locate(const void* position, uint32_t* line, uint32_t* column)
+{
+    if (!documentStart || !lineStarts || (const uint8_t*)position < documentStart)
+    {
+        *line = 0;
+        *column = 0;
+        return;
+    }
+
+    size_t offset = (size_t)((const uint8_t*)position - documentStart);
+
+    /* last line starting at or before offset */
+    size_t low = 0;
+    size_t high = lineCount;
+    while (high - low > 1)
+    {
+        size_t middle = low + (high - low) / 2;
+
+        if (lineStarts[middle] <= offset)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    *line = (uint32_t)(low + 1);
+    *column = (uint32_t)(offset - lineStarts[low] + 1);
+}
+
+static void ReportXmlError(size_t row, size_t column, const char* message)
+{
+    /* the xml parser unwinds with one message per level, only the first is the cause */
+    const char* reason = strstr(message, "::");
+    reason = reason ? reason + 2 : message;
+
+    if (!xmlErrorReported)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, currentPath, (uint32_t)row, (uint32_t)column, "malformed XML: %s", reason);
+        xmlErrorReported = true;
+    }
+    else
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_DEBUG, currentPath, (uint32_t)row, (uint32_t)column, "xml parser: %s", message);
+    }
+}
+
+static void DumpNode(OutputBuffer* output, const TreeNode* node, size_t depth, const char* rootFile)
+{
+    /* depth<TAB>class<TAB>name<TAB>[file:]line:column then one key=value field per property */
+    for (; node != NULL; node = node->sibling)
+    {
+        BufferPrintf(output, "%zu\t%s\t%s\t", depth, node->className ? node->className : "", node->instanceName ? node->instanceName : "");
+
+        if (node->file && (!rootFile || strcmp(node->file, rootFile) != 0))
+        {
+            BufferPrintf(output, "%s:", node->file);
+        }
+
+        BufferPrintf(output, "%u:%u", (unsigned)node->line, (unsigned)node->column);
+
+        if (node->deferred)
+        {
+            BufferPrintf(output, "\tDefer=True");
+        }
+
+        if (node->repeatCount)
+        {
+            BufferPrintf(output, "\tRepeat=%u", (unsigned)node->repeatCount);
+        }
+
+        if (node->component)
+        {
+            BufferPrintf(output, "\tClass=%s", node->component);
+        }
+
+        for (const NodeProperty* property = node->properties; property != NULL; property = property->next)
+        {
+            BufferPrintf(output, "\t%s=", property->key);
+            DumpEscaped(output, property->value);
+        }
+
+        if (node->items)
+        {
+            BufferPrintf(output, "\tPoolSize=%u\tItemBound=", (unsigned)node->items->poolSize);
+            DumpEscaped(output, node->items->itemBound ? node->items->itemBound : "");
+        }
+
+        BufferPrintf(output, "\n");
+
+        if (node->items && node->items->root)
+        {
+            DumpNode(output, node->items->root, depth + 1, rootFile);
+        }
+
+        if (node->child)
+        {
+            DumpNode(output, node->child, depth + 1, rootFile);
+        }
+    }
+}
+
+static void DumpEscaped(OutputBuffer* output, const char* string)
+{
+    const char* run = string;
+
+    for (; *string != '\0'; string++)
+    {
+        const char* escape = NULL;
+
+        switch (*string)
+        {
+            case '\t': escape = "\\t"; break;
+            case '\n': escape = "\\n"; break;
+            case '\r': escape = "\\r"; break;
+            case '\\': escape = "\\\\"; break;
+            default: break;
+        }
+
+        if (escape)
+        {
+            BufferWrite(output, run, (size_t)(string - run));
+            BufferWrite(output, escape, 2);
+            run = string + 1;
+        }
+    }
+
+    BufferWrite(output, run, (size_t)(string - run));
+}
+
+static void FreeNode(TreeNode* node)
+{
+    while (node)
+    {
+        TreeNode* nextSibling = node->sibling;
+
+        if (node->origin)
+        {
+            /* spliced from an include, only the default name is owned */
+            if (!node->origin->instanceName && node->instanceName) free((void*)node->instanceName);
+        }
+        else
+        {
+            if (node->className) free((void*)node->className);
+            if (node->instanceName) free((void*)node->instanceName);
+            if (node->component) free((void*)node->component);
+
+            NodeProperty* property = node->properties;
+            while (property)
+            {
+                NodeProperty* nextProperty = property->next;
+                free((void*)property->key);
+                free((void*)property->value);
+                free(property);
+                property = nextProperty;
+            }
+        }
+
+        if (node->items)
+        {
+            if (!node->origin) free((void*)node->items->itemBound);
+
+            FreeNode(node->items->root);
+            free(node->items);
+        }
+
+        if (node->child) FreeNode(node->child);
+        free(node);
+
+        node = nextSibling;
+    }
+}
@@ -19,6 +19,8 @@
 ***************************************************************/
 
 #include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
 
 /***************************************************************
 ** MARK: CONSTANTS & MACROS
@@ -34,28 +36,73 @@ typedef struct NodeProperty
 
     const char* key;
     const char* value;
+
+    uint32_t line;   /* position of the attribute in the source file, 1 based */
+    uint32_t column;
 } NodeProperty;
 
+/* <ItemTemplate> of a ListView or ItemsControl, generated once per pooled row instead of once per item */
+typedef struct ItemsTemplate
+{
+    struct TreeNode* root;      /* the single element inside <ItemTemplate>, its parent is the list */
+    uint32_t poolSize;          /* PoolSize attribute, rows realized at once */
+    const char* itemBound;      /* ItemBound attribute, user callback binding an item to a row */
+} ItemsTemplate;
+
 /* Generic tree node structure */
 typedef struct TreeNode
 {
     const char* className;      /* XML class*/
     const char* instanceName;   /* Name attribute */
+    bool named;                 /* instanceName came from the markup rather than DefaultInstanceName */
 
     NodeProperty* properties;   /* Linked list of properties */
+    NodeProperty* lastProperty; /* Tail of the properties list, for O(1) appends */
 
     struct TreeNode* parent; /* Pointer to the parent node */
     struct TreeNode* child; /* Pointer to the first child node */
+    struct TreeNode* lastChild; /* Pointer to the last child node, for O(1) appends */
     
     struct TreeNode* sibling; /* Pointer to the next sibling node */
     struct TreeNode* prevSibling; /* Pointer to the previous sibling node */
+
+    const struct TreeNode* origin; /* Cached include node this was spliced from, strings are borrowed */
+
+    bool deferred; /* Defer="True", built by a separate Realize function instead of _Create */
+
+    uint32_t repeatCount; /* Count of the enclosing <Repeat>, the member is an array built in a loop, 0 if not repeated */
+    bool repeatFirst;     /* First element spliced from a <Repeat>, its group runs to the next first or unrepeated sibling */
+
+    ItemsTemplate* items; /* ListView and ItemsControl only, the template is not in the child list */
+
+    const char* component; /* Class of a <UserControl> reference, the member is that module's struct, NULL otherwise */
+    bool runtimeLinks;     /* A child is repeated or a UserControl, so the children are linked in code, set once the tree is complete */
+
+    const char* file; /* Source file the node was read from, borrowed, NULL for in-memory input */
+    uint32_t line;    /* Position of the opening tag, 1 based */
+    uint32_t column;
 } TreeNode;
 
 /***************************************************************
 ** MARK: FUNCTION DEFS
 ***************************************************************/
 
-TreeNode* ParseFile(char* contents, size_t size, const char* moduleName);
+TreeNode* ParseFile(char* contents, size_t size, const char* moduleName, const char* path);
 void FreeFile(TreeNode* rootNode);
 
+/* True for the classes whose children are generated from an <ItemTemplate> */
+bool IsItemsClass(const char* className);
+
+/* Compact one line per node dump of a parsed tree, the caller frees the result */
+char* DumpTree(const TreeNode* rootNode, size_t* size);
+
+/* <Theme> elements of the last module in declaration order, linked through sibling, freed by FreeFile */
+const TreeNode* GetThemes(void);
+
+/* Files pulled in through <Include> while parsing the last module */
+size_t GetFileDependencies(const char* const** dependencies);
+
+/* Release every cached include tree, spliced nodes must be freed first */
+void ClearIncludeCache(void);
+
 #endif /* PARSER_H */
\ No newline at end of file
@@ -0,0 +1,267 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  pool.c
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen per module constant pool
+**
+***************************************************************/
+
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stats/alloc.h>
+
+#include <translator/translator.h>
+
+#include "pool.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define POOL_EMPTY ((size_t)-1)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+typedef enum
+{
+    POOL_STRING,
+    POOL_COLOR
+} PoolKind;
+
+typedef struct
+{
+    PoolKind kind;
+    char* value;        /* string contents, or the colour as six hex digits */
+    uint32_t rgb;
+    char* name;
+    uint32_t hash;
+} PoolEntry;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static bool enabled = false;
+static char moduleNameBuffer[256];
+
+static PoolEntry* entries = NULL;
+static size_t entryCount = 0;
+static size_t entryCapacity = 0;
+
+static size_t stringCount = 0;
+static size_t colorCount = 0;
+
+/* open addressing over entry indices, kept at most half full */
+static size_t* slots = NULL;
+static size_t slotCount = 0;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static const char* Intern(PoolKind kind, const char* value, uint32_t rgb);
+static uint32_t Hash(PoolKind kind, const char* value);
+static bool Grow(void);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void PoolBegin(const char* moduleName)
+{
+    PoolEnd();
+
+    snprintf(moduleNameBuffer, sizeof(moduleNameBuffer), "%s", moduleName);
+    enabled = true;
+}
+
+void PoolEnd(void)
+{
+    for (size_t i = 0; i < entryCount; i++)
+    {
+        free(entries[i].value);
+        free(entries[i].name);
+    }
+
+    free(entries);
+    free(slots);
+
+    entries = NULL;
+    entryCount = 0;
+    entryCapacity = 0;
+    stringCount = 0;
+    colorCount = 0;
+    slots = NULL;
+    slotCount = 0;
+
+    enabled = false;
+}
+
+bool PoolEnabled(void)
+{
+    return enabled;
+}
+
+const char* PoolString(const char* value)
+{
+    return Intern(POOL_STRING, value, 0);
+}
+
+const char* PoolColor(uint32_t rgb)
+{
+    char value[8];
+    snprintf(value, sizeof(value), "%06x", (unsigned)(rgb & 0xFFFFFFu));
+
+    return Intern(POOL_COLOR, value, rgb & 0xFFFFFFu);
+}
+
+void PoolWrite(OutputBuffer* output)
+{
+    if (entryCount == 0) return;
+
+    if (colorCount > 0)
+    {
+        WriteColorPacking(output);
+    }
+
+    for (size_t i = 0; i < entryCount; i++)
+    {
+        const PoolEntry* entry = &entries[i];
+
+        if (entry->kind == POOL_STRING)
+        {
+            BufferPrintf(output, "static const char %s[] = \"%s\";\n", entry->name, entry->value);
+        }
+        else
+        {
+            BufferPrintf(output, "static const nkColor_t %s = ", entry->name);
+            WritePackedColor(entry->rgb, output);
+            BufferPrintf(output, "; /* #%s */\n", entry->value);
+        }
+    }
+
+    BufferPrintf(output, "\n");
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static const char* Intern(PoolKind kind, const char* value, uint32_t rgb)
+{
+    if (!enabled) return NULL;
+
+    uint32_t hash = Hash(kind, value);
+
+    if (slotCount > 0)
+    {
+        for (size_t slot = hash & (slotCount - 1); slots[slot] != POOL_EMPTY; slot = (slot + 1) & (slotCount - 1))
+        {
+            const PoolEntry* entry = &entries[slots[slot]];
+
+            if (entry->hash == hash && entry->kind == kind && strcmp(entry->value, value) == 0)
+            {
+                return entry->name;
+            }
+        }
+    }
+
+    if ((entryCount + 1) * 2 > slotCount && !Grow()) return NULL;
+
+    if (entryCount == entryCapacity)
+    {
+        size_t capacity = entryCapacity ? entryCapacity * 2 : 64;
+        PoolEntry* grown = (PoolEntry*)realloc(entries, capacity * sizeof(PoolEntry));
+
+        if (!grown) return NULL;
+
+        entries = grown;
+        entryCapacity = capacity;
+    }
+
+    char name[320];
+    snprintf(name, sizeof(name), "%s_%s%zu", moduleNameBuffer, (kind == POOL_STRING) ? "string" : "color", (kind == POOL_STRING) ? stringCount : colorCount);
+
+    PoolEntry* entry = &entries[entryCount];
+    entry->kind = kind;
+    entry->rgb = rgb;
+    entry->hash = hash;
+    entry->value = (char*)malloc(strlen(value) + 1);
+    entry->name = (char*)malloc(strlen(name) + 1);
+
+    if (!entry->value || !entry->name)
+    {
+        free(entry->value);
+        free(entry->name);
+        return NULL;
+    }
+
+    strcpy(entry->value, value);
+    strcpy(entry->name, name);
+
+    size_t slot = hash & (slotCount - 1);
+    while (slots[slot] != POOL_EMPTY) slot = (slot + 1) & (slotCount - 1);
+    slots[slot] = entryCount++;
+
+    if (kind == POOL_STRING)
+    {
+        stringCount++;
+    }
+    else
+    {
+        colorCount++;
+    }
+
+    return entry->name;
+}
+
+static uint32_t Hash(PoolKind kind, const char* value)
+{
+    /* FNV-1a, seeded with the kind so a string and a colour never compare */
+    uint32_t hash = 2166136261u ^ (uint32_t)kind;
+
+    for (; *value != '\0'; value++)
+    {
+        hash ^= (uint8_t)*value;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static bool Grow(void)
+{
+    size_t count = slotCount ? slotCount * 2 : 128;
+    size_t* grown = (size_t*)malloc(count * sizeof(size_t));
+
+    if (!grown) return false;
+
+    for (size_t i = 0; i < count; i++) grown[i] = POOL_EMPTY;
+
+    for (size_t i = 0; i < entryCount; i++)
+    {
+        size_t slot = entries[i].hash & (count - 1);
+        while (grown[slot] != POOL_EMPTY) slot = (slot + 1) & (count - 1);
+        grown[slot] = i;
+    }
+
+    free(slots);
+    slots = grown;
+    slotCount = count;
+
+    return true;
+}
@@ -0,0 +1,52 @@
+/***************************************************************
+**
+** NanoKit Tool Header File
+**
+** File         :  pool.h
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen per module constant pool
+**
+***************************************************************/
+
+#ifndef POOL_H
+#define POOL_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <buffer/buffer.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* Starts interning for one module, entries are named <moduleName>_string<n> and <moduleName>_color<n> */
+void PoolBegin(const char* moduleName);
+void PoolEnd(void);
+
+bool PoolEnabled(void);
+
+/* Name of the pooled constant holding the value, equal values share one entry */
+const char* PoolString(const char* value);
+const char* PoolColor(uint32_t rgb);
+
+/* Definitions of every entry interned so far, in first use order */
+void PoolWrite(OutputBuffer* output);
+
+#endif /* POOL_H */
@@ -0,0 +1,322 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  route.c
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen static event routes behind _Dispatch
+**
+***************************************************************/
+
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stats/alloc.h>
+
+#include <binding/binding.h>
+#include <theme/theme.h>
+#include <lookup/lookup.h>
+
+#include "route.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* One routed attribute, in document order */
+typedef struct
+{
+    const NodeProperty* property;
+    PropertyType type;
+    size_t viewId;
+    size_t event;
+    size_t handler;
+} RouteEntry;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static RouteEntry* entries = NULL;
+static size_t entryCount = 0;
+static size_t entryCapacity = 0;
+
+static const char** events = NULL;
+static size_t eventCount = 0;
+static size_t eventCapacity = 0;
+
+static RouteHandler* handlers = NULL;
+static size_t handlerCount = 0;
+
+/* viewCount rows of eventCount handler indices plus one */
+static size_t* routes = NULL;
+static size_t routeViewCount = 0;
+
+/* the routed attributes ordered by address, for IsRouted */
+static const NodeProperty** routedProperties = NULL;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static bool AddEntry(const NodeProperty* property, PropertyType type, size_t viewId);
+static bool FindEvent(const char* name, size_t* event);
+static bool AssignHandlers(void);
+
+static int CompareEntryNames(const void* a, const void* b);
+static int CompareProperties(const void* a, const void* b);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool CollectRoutes(const TreeNode* rootNode)
+{
+    ClearRoutes();
+
+    if (!rootNode) return true;
+
+    size_t viewCount = GetViewIdCount();
+
+    for (size_t id = 0; id < viewCount; id++)
+    {
+        const TreeNode* node = GetViewIdNode(id);
+
+        /* a UserControl routes its own views through its own module */
+        if (node->component) continue;
+
+        for (const NodeProperty* property = node->properties; property != NULL; property = property->next)
+        {
+            if (IsBinding(property->value) || IsThemeResource(property->value)) continue; /* the view model may change it at runtime */
+
+            bool isInherited = false;
+            PropertyType type = ResolvePropertyType(node->className, property->key, &isInherited);
+
+            if (type < TYPE_GENERIC_CALLBACK) continue;
+
+            if (!AddEntry(property, type, id))
+            {
+                ClearRoutes();
+                return false;
+            }
+        }
+    }
+
+    if (entryCount == 0) return true;
+
+    routes = (size_t*)calloc(viewCount * eventCount, sizeof(size_t));
+    routedProperties = (const NodeProperty**)malloc(entryCount * sizeof(const NodeProperty*));
+
+    if (!routes || !routedProperties || !AssignHandlers())
+    {
+        ClearRoutes();
+        return false;
+    }
+
+    routeViewCount = viewCount;
+
+    /* in document order, so a repeated attribute wins as its store would */
+    for (size_t i = 0; i < entryCount; i++)
+    {
+        routes[entries[i].viewId * eventCount + entries[i].event] = entries[i].handler + 1;
+        routedProperties[i] = entries[i].property;
+    }
+
+    qsort(routedProperties, entryCount, sizeof(const NodeProperty*), CompareProperties);
+
+    return true;
+}
+
+void ClearRoutes(void)
+{
+    free(entries);
+    free(events);
+    free(handlers);
+    free(routes);
+    free(routedProperties);
+
+    entries = NULL;
+    entryCount = 0;
+    entryCapacity = 0;
+    events = NULL;
+    eventCount = 0;
+    eventCapacity = 0;
+    handlers = NULL;
+    handlerCount = 0;
+    routes = NULL;
+    routeViewCount = 0;
+    routedProperties = NULL;
+}
+
+size_t GetEventCount(void)
+{
+    return routes ? eventCount : 0;
+}
+
+const char* GetEventName(size_t event)
+{
+    return (routes && event < eventCount) ? events[event] : NULL;
+}
+
+size_t GetHandlerCount(void)
+{
+    return handlerCount;
+}
+
+const RouteHandler* GetHandler(size_t handler)
+{
+    return (handler < handlerCount) ? &handlers[handler] : NULL;
+}
+
+size_t GetRoute(size_t viewId, size_t event)
+{
+    if (!routes || viewId >= routeViewCount || event >= eventCount) return 0;
+
+    return routes[viewId * eventCount + event];
+}
+
+bool IsRouted(const NodeProperty* property)
+{
+    if (!routes) return false;
+
+    size_t low = 0;
+    size_t high = entryCount;
+
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+
+        if (routedProperties[middle] == property) return true;
+
+        if ((uintptr_t)routedProperties[middle] < (uintptr_t)property)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return false;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static bool AddEntry(const NodeProperty* property, PropertyType type, size_t viewId)
+{
+    size_t event = 0;
+
+    if (!FindEvent(property->key, &event)) return false;
+
+    if (entryCount == entryCapacity)
+    {
+        size_t capacity = entryCapacity ? entryCapacity * 2 : 32;
+        RouteEntry* grown = (RouteEntry*)realloc(entries, capacity * sizeof(RouteEntry));
+
+        if (!grown) return false;
+
+        entries = grown;
+        entryCapacity = capacity;
+    }
+
+    entries[entryCount++] = (RouteEntry){ property, type, viewId, event, 0 };
+    return true;
+}
+
+static bool FindEvent(const char* name, size_t* event)
+{
+    /* a handful of attribute names at most, a scan is enough */
+    for (size_t i = 0; i < eventCount; i++)
+    {
+        if (strcmp(events[i], name) == 0)
+        {
+            *event = i;
+            return true;
+        }
+    }
+
+    if (eventCount == eventCapacity)
+    {
+        size_t capacity = eventCapacity ? eventCapacity * 2 : 8;
+        const char** grown = (const char**)realloc(events, capacity * sizeof(const char*));
+
+        if (!grown) return false;
+
+        events = grown;
+        eventCapacity = capacity;
+    }
+
+    *event = eventCount;
+    events[eventCount++] = name;
+    return true;
+}
+
+static bool AssignHandlers(void)
+{
+    /* sorted by name, equal names are one handler whatever the number of views naming it */
+    RouteEntry** byName = (RouteEntry**)malloc(entryCount * sizeof(RouteEntry*));
+    handlers = (RouteHandler*)malloc(entryCount * sizeof(RouteHandler));
+
+    if (!byName || !handlers)
+    {
+        free(byName);
+        return false;
+    }
+
+    for (size_t i = 0; i < entryCount; i++)
+    {
+        byName[i] = &entries[i];
+    }
+
+    qsort(byName, entryCount, sizeof(RouteEntry*), CompareEntryNames);
+
+    for (size_t i = 0; i < entryCount; i++)
+    {
+        if (i == 0 || CompareEntryNames(&byName[i - 1], &byName[i]) != 0)
+        {
+            handlers[handlerCount++] = (RouteHandler){ byName[i]->property->value, byName[i]->type };
+        }
+
+        byName[i]->handler = handlerCount - 1;
+    }
+
+    free(byName);
+    return true;
+}
+
+static int CompareEntryNames(const void* a, const void* b)
+{
+    const RouteEntry* entryA = *(const RouteEntry* const*)a;
+    const RouteEntry* entryB = *(const RouteEntry* const*)b;
+
+    int order = strcmp(entryA->property->value, entryB->property->value);
+
+    if (order != 0) return order;
+
+    /* one name with two sender types is two cases, the user code decides which compiles */
+    return (entryA->type < entryB->type) ? -1 : (entryA->type > entryB->type) ? 1 : 0;
+}
+
+static int CompareProperties(const void* a, const void* b)
+{
+    uintptr_t propertyA = (uintptr_t)*(const NodeProperty* const*)a;
+    uintptr_t propertyB = (uintptr_t)*(const NodeProperty* const*)b;
+
+    return (propertyA < propertyB) ? -1 : (propertyA > propertyB) ? 1 : 0;
+}
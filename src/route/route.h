@@ -0,0 +1,66 @@
+/***************************************************************
+**
+** NanoKit Tool Header File
+**
+** File         :  route.h
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen static event routes behind _Dispatch
+**
+***************************************************************/
+
+#ifndef ROUTE_H
+#define ROUTE_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <parser/parser.h>
+#include <translator/translator.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* A user function some routed callback names, one case of the generated switch */
+typedef struct
+{
+    const char* name;
+    PropertyType type;  /* decides the sender cast */
+} RouteHandler;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* Moves the callbacks of every member view into a table indexed by view ID and event,
+   needs the view IDs, bound callbacks, list rows and UserControls keep their stores */
+bool CollectRoutes(const TreeNode* rootNode);
+void ClearRoutes(void);
+
+/* Events are the distinct callback attributes in first use order, 0 unless routes were collected */
+size_t GetEventCount(void);
+const char* GetEventName(size_t event);
+
+/* Handlers are ordered by name */
+size_t GetHandlerCount(void);
+const RouteHandler* GetHandler(size_t handler);
+
+/* Handler index plus one, 0 where the view does not handle the event */
+size_t GetRoute(size_t viewId, size_t event);
+
+/* True if the attribute lives in the route table, its store is not written */
+bool IsRouted(const NodeProperty* property);
+
+#endif /* ROUTE_H */
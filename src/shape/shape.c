@@ -0,0 +1,555 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  shape.c
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen structural sharing of identical subtrees
+**
+***************************************************************/
+
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stats/alloc.h>
+
+#include <binding/binding.h>
+#include <theme/theme.h>
+#include <route/route.h>
+
+#include "shape.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define SHAPE_NONE ((size_t)-1)
+
+#define SHAPE_MIN_WEIGHT 3  /* views plus written properties, smaller subtrees are cheaper inline than as a call */
+#define SHAPE_MAX_NODES 32  /* bounds the helper parameter list */
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* One structurally distinct subtree, shared when it is written at least twice */
+typedef struct
+{
+    Shape shape;
+    size_t count;       /* occurrences anywhere in the tree */
+    bool shared;
+} Candidate;
+
+typedef struct
+{
+    const TreeNode* node;
+    size_t candidate;
+} NodeEntry;
+
+/* What a parent needs from one analysed child */
+typedef struct
+{
+    bool eligible;      /* nothing in the subtree is written differently per occurrence */
+    uint32_t hash;
+    size_t nodeCount;
+    size_t height;
+    size_t weight;
+} Summary;
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static Candidate* candidates = NULL;
+static size_t candidateCount = 0;
+static size_t candidateCapacity = 0;
+
+static NodeEntry* nodeEntries = NULL;
+static size_t nodeEntryCount = 0;
+static size_t nodeEntryCapacity = 0;
+
+/* open addressing over candidate and node entry indices, kept at most half full */
+static size_t* candidateSlots = NULL;
+static size_t candidateSlotCount = 0;
+static size_t* nodeSlots = NULL;
+static size_t nodeSlotCount = 0;
+
+/* subtrees InitialiseNode is started on besides the module root */
+static const TreeNode** roots = NULL;
+static size_t rootCount = 0;
+static size_t rootCapacity = 0;
+
+/* shared candidates, shortest first */
+static size_t* helpers = NULL;
+static size_t helperCount = 0;
+
+static bool collectRows = false;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static Summary Analyse(const TreeNode* node);
+static bool AddOccurrence(const TreeNode* node, const Summary* summary);
+static size_t NodeCandidate(const TreeNode* node);
+static bool SameShape(const TreeNode* a, const TreeNode* b);
+static const NodeProperty* NextWritten(const NodeProperty* property);
+
+static void CountUses(const TreeNode* node, const TreeNode* helperRoot);
+static int CompareHelpers(const void* a, const void* b);
+
+static bool AddRoot(const TreeNode* node);
+static bool GrowSlots(size_t** slots, size_t* slotCount, size_t entryCount, bool forNodes);
+static uint32_t PointerHash(const TreeNode* node);
+static uint32_t Mix(uint32_t hash, const char* string);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void CollectShapes(const TreeNode* rootNode, bool mainTree, bool listRows)
+{
+    ClearShapes();
+
+    if (!rootNode) return;
+
+    collectRows = listRows;
+    Analyse(rootNode);
+
+    for (size_t i = 0; i < candidateCount; i++)
+    {
+        candidates[i].shared = candidates[i].count >= 2;
+    }
+
+    /* a subtree only found inside larger shared ones is written once, in their helper,
+       so uses are counted over what is actually written until no helper drops out */
+    bool changed = true;
+
+    while (changed)
+    {
+        changed = false;
+
+        for (size_t i = 0; i < candidateCount; i++)
+        {
+            candidates[i].shape.uses = 0;
+        }
+
+        if (mainTree)
+        {
+            CountUses(rootNode, NULL);
+        }
+
+        for (size_t i = 0; i < rootCount; i++)
+        {
+            CountUses(roots[i], NULL);
+        }
+
+        for (size_t i = 0; i < candidateCount; i++)
+        {
+            if (candidates[i].shared)
+            {
+                CountUses(candidates[i].shape.node, candidates[i].shape.node);
+            }
+        }
+
+        for (size_t i = 0; i < candidateCount; i++)
+        {
+            if (candidates[i].shared && candidates[i].shape.uses < 2)
+            {
+                candidates[i].shared = false;
+                changed = true;
+            }
+        }
+    }
+
+    size_t sharedCount = 0;
+
+    for (size_t i = 0; i < candidateCount; i++)
+    {
+        if (candidates[i].shared) sharedCount++;
+    }
+
+    if (sharedCount == 0) return;
+
+    helpers = (size_t*)malloc(sharedCount * sizeof(size_t));
+
+    if (!helpers)
+    {
+        ClearShapes();
+        return;
+    }
+
+    for (size_t i = 0; i < candidateCount; i++)
+    {
+        if (!candidates[i].shared) continue;
+
+        /* the hash names the helper, distinct shapes that collide are moved along */
+        for (size_t j = 0; j < helperCount; j++)
+        {
+            if (candidates[helpers[j]].shape.hash == candidates[i].shape.hash)
+            {
+                candidates[i].shape.hash++;
+                j = (size_t)-1;
+            }
+        }
+
+        helpers[helperCount++] = i;
+    }
+
+    qsort(helpers, helperCount, sizeof(size_t), CompareHelpers);
+
+    for (size_t i = 0; i < helperCount; i++)
+    {
+        candidates[helpers[i]].shape.index = i;
+    }
+}
+
+void ClearShapes(void)
+{
+    free(candidates);
+    free(nodeEntries);
+    free(candidateSlots);
+    free(nodeSlots);
+    free(roots);
+    free(helpers);
+
+    candidates = NULL;
+    candidateCount = 0;
+    candidateCapacity = 0;
+    nodeEntries = NULL;
+    nodeEntryCount = 0;
+    nodeEntryCapacity = 0;
+    candidateSlots = NULL;
+    candidateSlotCount = 0;
+    nodeSlots = NULL;
+    nodeSlotCount = 0;
+    roots = NULL;
+    rootCount = 0;
+    rootCapacity = 0;
+    helpers = NULL;
+    helperCount = 0;
+}
+
+size_t GetShapeCount(void)
+{
+    return helperCount;
+}
+
+const Shape* GetShape(size_t index)
+{
+    return (index < helperCount) ? &candidates[helpers[index]].shape : NULL;
+}
+
+const Shape* FindShape(const TreeNode* node)
+{
+    if (helperCount == 0) return NULL;
+
+    size_t candidate = NodeCandidate(node);
+
+    return (candidate != SHAPE_NONE && candidates[candidate].shared) ? &candidates[candidate].shape : NULL;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static Summary Analyse(const TreeNode* node)
+{
+    /* Window is created with its title and size, deferred and repeated views are written per occurrence,
+       a UserControl already shares its code through its own _Create */
+    Summary summary = {
+        .eligible = !node->deferred && !node->repeatCount && !node->component && strcmp(node->className, "Window") != 0,
+        .hash = Mix(2166136261u, node->className),
+        .nodeCount = 1,
+        .height = 1,
+        .weight = 1
+    };
+
+    /* bindings and themes are applied to the named member later and routes are not written, they do not change what is written here */
+    for (const NodeProperty* property = NextWritten(node->properties); property != NULL; property = NextWritten(property->next))
+    {
+        summary.hash = Mix(Mix(summary.hash, property->key), property->value);
+        summary.weight++;
+    }
+
+    if (node->deferred && !AddRoot(node))
+    {
+        summary.eligible = false;
+    }
+
+    if (node->items && node->items->root)
+    {
+        /* a row is written by its own loop, it does not make the list differ */
+        Analyse(node->items->root);
+
+        if (collectRows && !AddRoot(node->items->root))
+        {
+            summary.eligible = false;
+        }
+    }
+
+    size_t childCount = 0;
+
+    for (const TreeNode* child = node->child; child != NULL; child = child->sibling)
+    {
+        Summary childSummary = Analyse(child);
+
+        summary.eligible = summary.eligible && childSummary.eligible;
+        summary.nodeCount += childSummary.nodeCount;
+        summary.weight += childSummary.weight;
+
+        if (childSummary.height + 1 > summary.height)
+        {
+            summary.height = childSummary.height + 1;
+        }
+
+        for (size_t i = 0; i < 4; i++)
+        {
+            summary.hash ^= (childSummary.hash >> (i * 8)) & 0xFFu;
+            summary.hash *= 16777619u;
+        }
+
+        childCount++;
+    }
+
+    summary.hash ^= (uint32_t)childCount;
+    summary.hash *= 16777619u;
+
+    if (summary.eligible && summary.nodeCount <= SHAPE_MAX_NODES && summary.weight >= SHAPE_MIN_WEIGHT && !AddOccurrence(node, &summary))
+    {
+        summary.eligible = false;
+    }
+
+    return summary;
+}
+
+static bool AddOccurrence(const TreeNode* node, const Summary* summary)
+{
+    size_t candidate = SHAPE_NONE;
+
+    if (candidateSlotCount > 0)
+    {
+        for (size_t slot = summary->hash & (candidateSlotCount - 1); candidateSlots[slot] != SHAPE_NONE; slot = (slot + 1) & (candidateSlotCount - 1))
+        {
+            const Shape* shape = &candidates[candidateSlots[slot]].shape;
+
+            if (shape->hash == summary->hash && SameShape(shape->node, node))
+            {
+                candidate = candidateSlots[slot];
+                break;
+            }
+        }
+    }
+
+    if (candidate == SHAPE_NONE)
+    {
+        if ((candidateCount + 1) * 2 > candidateSlotCount && !GrowSlots(&candidateSlots, &candidateSlotCount, candidateCount, false)) return false;
+
+        if (candidateCount == candidateCapacity)
+        {
+            size_t capacity = candidateCapacity ? candidateCapacity * 2 : 64;
+            Candidate* grown = (Candidate*)realloc(candidates, capacity * sizeof(Candidate));
+
+            if (!grown) return false;
+
+            candidates = grown;
+            candidateCapacity = capacity;
+        }
+
+        candidate = candidateCount++;
+        candidates[candidate] = (Candidate){
+            .shape = { node, summary->hash, summary->nodeCount, summary->height, 0 },
+            .count = 0,
+            .shared = false
+        };
+
+        size_t slot = summary->hash & (candidateSlotCount - 1);
+        while (candidateSlots[slot] != SHAPE_NONE) slot = (slot + 1) & (candidateSlotCount - 1);
+        candidateSlots[slot] = candidate;
+    }
+
+    candidates[candidate].count++;
+
+    if ((nodeEntryCount + 1) * 2 > nodeSlotCount && !GrowSlots(&nodeSlots, &nodeSlotCount, nodeEntryCount, true)) return false;
+
+    if (nodeEntryCount == nodeEntryCapacity)
+    {
+        size_t capacity = nodeEntryCapacity ? nodeEntryCapacity * 2 : 256;
+        NodeEntry* grown = (NodeEntry*)realloc(nodeEntries, capacity * sizeof(NodeEntry));
+
+        if (!grown) return false;
+
+        nodeEntries = grown;
+        nodeEntryCapacity = capacity;
+    }
+
+    nodeEntries[nodeEntryCount] = (NodeEntry){ node, candidate };
+
+    size_t slot = PointerHash(node) & (nodeSlotCount - 1);
+    while (nodeSlots[slot] != SHAPE_NONE) slot = (slot + 1) & (nodeSlotCount - 1);
+    nodeSlots[slot] = nodeEntryCount++;
+
+    return true;
+}
+
+static size_t NodeCandidate(const TreeNode* node)
+{
+    if (nodeSlotCount == 0) return SHAPE_NONE;
+
+    for (size_t slot = PointerHash(node) & (nodeSlotCount - 1); nodeSlots[slot] != SHAPE_NONE; slot = (slot + 1) & (nodeSlotCount - 1))
+    {
+        if (nodeEntries[nodeSlots[slot]].node == node)
+        {
+            return nodeEntries[nodeSlots[slot]].candidate;
+        }
+    }
+
+    return SHAPE_NONE;
+}
+
+static bool SameShape(const TreeNode* a, const TreeNode* b)
+{
+    if (strcmp(a->className, b->className) != 0) return false;
+
+    const NodeProperty* propertyA = NextWritten(a->properties);
+    const NodeProperty* propertyB = NextWritten(b->properties);
+
+    while (propertyA && propertyB)
+    {
+        if (strcmp(propertyA->key, propertyB->key) != 0 || strcmp(propertyA->value, propertyB->value) != 0) return false;
+
+        propertyA = NextWritten(propertyA->next);
+        propertyB = NextWritten(propertyB->next);
+    }
+
+    if (propertyA || propertyB) return false;
+
+    const TreeNode* childA = a->child;
+    const TreeNode* childB = b->child;
+
+    while (childA && childB)
+    {
+        if (!SameShape(childA, childB)) return false;
+
+        childA = childA->sibling;
+        childB = childB->sibling;
+    }
+
+    return childA == NULL && childB == NULL;
+}
+
+static const NodeProperty* NextWritten(const NodeProperty* property)
+{
+    while (property && (IsBinding(property->value) || IsThemeResource(property->value) || IsRouted(property)))
+    {
+        property = property->next;
+    }
+
+    return property;
+}
+
+static void CountUses(const TreeNode* node, const TreeNode* helperRoot)
+{
+    /* mirrors InitialiseNode: a shared subtree is a single call, deferred children have their own Realize */
+    size_t candidate = NodeCandidate(node);
+
+    if (candidate != SHAPE_NONE && candidates[candidate].shared && node != helperRoot)
+    {
+        candidates[candidate].shape.uses++;
+        return;
+    }
+
+    for (const TreeNode* child = node->child; child != NULL; child = child->sibling)
+    {
+        if (!child->deferred)
+        {
+            CountUses(child, helperRoot);
+        }
+    }
+}
+
+static int CompareHelpers(const void* a, const void* b)
+{
+    size_t indexA = *(const size_t*)a;
+    size_t indexB = *(const size_t*)b;
+    size_t heightA = candidates[indexA].shape.height;
+    size_t heightB = candidates[indexB].shape.height;
+
+    if (heightA != heightB) return (heightA < heightB) ? -1 : 1;
+
+    return (indexA < indexB) ? -1 : (indexA > indexB) ? 1 : 0;
+}
+
+static bool AddRoot(const TreeNode* node)
+{
+    if (rootCount == rootCapacity)
+    {
+        size_t capacity = rootCapacity ? rootCapacity * 2 : 16;
+        const TreeNode** grown = (const TreeNode**)realloc(roots, capacity * sizeof(const TreeNode*));
+
+        if (!grown) return false;
+
+        roots = grown;
+        rootCapacity = capacity;
+    }
+
+    roots[rootCount++] = node;
+    return true;
+}
+
+static bool GrowSlots(size_t** slots, size_t* slotCount, size_t entryCount, bool forNodes)
+{
+    size_t count = *slotCount ? *slotCount * 2 : 128;
+    size_t* grown = (size_t*)malloc(count * sizeof(size_t));
+
+    if (!grown) return false;
+
+    for (size_t i = 0; i < count; i++) grown[i] = SHAPE_NONE;
+
+    for (size_t i = 0; i < entryCount; i++)
+    {
+        uint32_t hash = forNodes ? PointerHash(nodeEntries[i].node) : candidates[i].shape.hash;
+
+        size_t slot = hash & (count - 1);
+        while (grown[slot] != SHAPE_NONE) slot = (slot + 1) & (count - 1);
+        grown[slot] = i;
+    }
+
+    free(*slots);
+    *slots = grown;
+    *slotCount = count;
+
+    return true;
+}
+
+static uint32_t PointerHash(const TreeNode* node)
+{
+    /* nodes are heap blocks, the low bits carry no information */
+    uint64_t value = (uint64_t)(uintptr_t)node >> 4;
+
+    return (uint32_t)(value ^ (value >> 32)) * 2654435761u;
+}
+
+static uint32_t Mix(uint32_t hash, const char* string)
+{
+    /* FNV-1a, the terminator is hashed too so "ab" "c" and "a" "bc" differ */
+    for (; *string != '\0'; string++)
+    {
+        hash ^= (uint8_t)*string;
+        hash *= 16777619u;
+    }
+
+    hash ^= 0xFFu;
+    hash *= 16777619u;
+
+    return hash;
+}
@@ -0,0 +1,61 @@
+/***************************************************************
+**
+** NanoKit Tool Header File
+**
+** File         :  shape.h
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen structural sharing of identical subtrees
+**
+***************************************************************/
+
+#ifndef SHAPE_H
+#define SHAPE_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <parser/parser.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* A subtree written once as an init helper, every occurrence calls it with its own views */
+typedef struct
+{
+    const TreeNode* node;   /* first occurrence, the helper body is written from it */
+    uint32_t hash;          /* structural hash, unique per module, names the helper */
+    size_t nodeCount;       /* views in the subtree, one helper parameter each in pre-order */
+    size_t height;          /* helpers are ordered shortest first so nested ones are defined before use */
+    size_t uses;            /* call sites left once larger shared subtrees are accounted for */
+    size_t index;           /* position among the helpers, GetShape(index) returns this shape */
+} Shape;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* Hashes every subtree of a validated tree and keeps the shapes that would be written at least twice,
+   mainTree is false when _Create does not unroll the tree, listRows when rows may call helpers */
+void CollectShapes(const TreeNode* rootNode, bool mainTree, bool listRows);
+void ClearShapes(void);
+
+size_t GetShapeCount(void);
+const Shape* GetShape(size_t index);
+
+/* The shape a node is an occurrence of, NULL if it is written inline */
+const Shape* FindShape(const TreeNode* node);
+
+#endif /* SHAPE_H */
@@ -19,9 +19,22 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <stats/alloc.h>
+
 #include <xml/xml.h>
 
 #include <translator/translator.h>
+#include <binding/binding.h>
+#include <theme/theme.h>
+#include <items/items.h>
+#include <layout/layout.h>
+#include <pool/pool.h>
+#include <lookup/lookup.h>
+#include <route/route.h>
+#include <members/members.h>
+#include <shape/shape.h>
+#include <split/split.h>
+#include <diagnostics/diagnostics.h>
 
 #include "source.h"
 
@@ -33,45 +46,187 @@
 ** MARK: TYPEDEFS
 ***************************************************************/
 
+/* What the support blocks need ahead of them, each is written once however many blocks ask for it */
+typedef enum
+{
+    SUPPORT_STDBOOL = 1 << 0,
+    SUPPORT_STDDEF = 1 << 1,
+    SUPPORT_STDINT = 1 << 2,
+    SUPPORT_STRING = 1 << 3,
+    SUPPORT_INVALIDATE = 1 << 4
+} SupportNeed;
+
+/* A helper written out at a call site, what does not depend on the occurrence plus, per view in pre-order,
+   the references that would name its member, as a pointer or member access or as a comment label */
+typedef struct
+{
+    size_t fixedBytes;
+    size_t* references;
+    size_t* labels;
+} ShapeExpansion;
+
+/* A constant field of the node being written, its copy range waits until the node's fields are ordered */
+typedef struct
+{
+    size_t order;
+    const char* fieldName;
+    bool isInherited;
+} PrototypeField;
+
 /***************************************************************
 ** MARK: STATIC VARIABLES
 ***************************************************************/
 
-static char* outputBuffer = NULL;
-static size_t outputBufferSize = 0;
-static size_t positionInFile = 0;
+static OutputBuffer output;
 
 static char moduleNameBuffer[256];
 static char moduleNameUpper[256];
 
 static TreeNode* rootNode = NULL;
 
+static bool staticLinks = false;
+
+/* how InitialiseNode reaches a view, "row->" while writing the rows of a list */
+static const char* instanceBase = "this->";
+
+/* shared init helpers, views of the subtree being written as one are reached through parameters */
+static bool shareShapes = false;
+static const TreeNode* helperRoot = NULL;
+
+/* what the calls would have been written as inline, nested calls are expanded into the helper calling them */
+static ShapeExpansion* shapeExpansions = NULL;
+static ShapeExpansion* helperExpansion = NULL;
+static size_t helperParameterBytes = 0;
+static size_t helperCallBytes = 0;
+static size_t sharedInlineBytes = 0;
+static size_t sharedWrittenBytes = 0;
+static size_t sharedHelperCount = 0;
+static size_t sharedBytesSaved = 0;
+
+/* split sources, a cut subtree is written by its own function and called where it would have been inline */
+static const TreeNode* cutRoot = NULL;
+static bool exportHelpers = false;
+
+/* definition of the module struct when the header only forward declares it */
+static const char* moduleStruct = NULL;
+
+/* support blocks only note what they need, it is spliced in ahead of them once the source is written */
+static unsigned supportNeeds = 0;
+
+/* a few references are formatted into one statement, each gets its own buffer */
+static char references[4][320];
+static size_t nextReference = 0;
+
+/* table backend, filled in one pass and appended after the node table */
+static OutputBuffer propertyTable;
+static OutputBuffer runtimeValues;
+static size_t tableNodeCount = 0;
+
+/* prototype backend, one designated initializer and one copy range per constant field,
+   each node's ranges in field order so the copy merges the ones that touch */
+static OutputBuffer prototypeFields;
+static OutputBuffer prototypeRanges;
+static OutputBuffer constructorCalls;
+static OutputBuffer linkCalls;
+static size_t prototypeRangeCount = 0;
+static PrototypeField* nodeFields = NULL;
+static size_t nodeFieldCapacity = 0;
+
+/* static links, one row per view with a parent, child or sibling */
+static size_t linkRowCount = 0;
+
 /***************************************************************
 ** MARK: STATIC FUNCTION DEFS
 ***************************************************************/
 
 static void InitialiseNode(TreeNode *node);
+static void InitialiseChildren(TreeNode* node, bool repeatsOnly);
+static TreeNode* WriteRepeat(TreeNode* parent, TreeNode* first);
+static void WriteRepeatGroups(TreeNode* node);
+static void WriteAddChild(const TreeNode* parent, const TreeNode* child);
+static void WriteIndented(const OutputBuffer* source, OutputBuffer* target);
+static bool LinksAtRuntime(const TreeNode* node);
+
+static const char* ViewPointer(const TreeNode* node);
+static const char* ViewMember(const TreeNode* node);
+static const char* ViewLabel(const TreeNode* node);
+static bool FindPreorder(const TreeNode* root, const TreeNode* node, size_t* index);
+static void CountParameter(size_t index, const char* reference);
+
+static void WriteShapeHelpers(void);
+static void WriteShapeCall(const Shape* shape, const TreeNode* node);
+static void WriteShapeArguments(const TreeNode* node, bool* first);
+static size_t ExpandShapeCall(const ShapeExpansion* expansion, const TreeNode* node, size_t* index);
+static void ClearShapeExpansions(void);
+static void WriteShapeSignature(const Shape* shape, bool prototype);
+static void WriteWindowCreate(TreeNode* node, OutputBuffer* target);
+
+static void WriteBanner(const char* path);
+static void WriteAccessors(TreeNode* node);
+static void WriteCutFunctions(size_t chunk);
+static void WriteCutPrototypes(void);
+static char* WriteChunk(const char* path, size_t chunk, bool poolConstants, size_t* size);
+
+static void WriteTableBuilder(void);
+static void WriteTables(TreeNode* node);
+static void WriteTableNode(TreeNode* node, size_t parentIndex);
+
+static void WritePrototype(TreeNode* node);
+static void WritePrototypeNode(TreeNode* node);
+static bool IsOverridden(const TreeNode* node, const NodeProperty* property);
+static int ComparePrototypeFields(const void* a, const void* b);
+
+static void WritePool(size_t position);
+static void WriteSupportPreamble(size_t position);
+
+static void WriteLinkSupport(bool withTable);
+static void WriteLinkRows(TreeNode* node, OutputBuffer* target);
+static void WriteLinkStores(TreeNode* node, OutputBuffer* target, bool viewFields);
+
+static void WriteRealizeFlags(TreeNode* node, OutputBuffer* target);
+static void WriteRealizeFunctions(TreeNode* node);
+static void WriteInsertChild(const TreeNode* node);
+static const char* SiblingMember(const TreeNode* node);
+static bool InsertsDeferred(const TreeNode* node);
+static TreeNode* NextEager(TreeNode* node);
+
+static void WriteLayoutSupport(bool withTable);
+static void WriteLayoutFrames(SourceBackend backend);
+static void WriteRect(const LayoutFrame* frame, bool isLiteral, OutputBuffer* target);
+static void WriteFloat(float value, OutputBuffer* target);
+
+static void WriteBindingSupport(void);
+static void WriteBindingSync(const TreeNode* deferred);
+static void WriteBindingSetters(void);
+static void WriteBindingApply(void);
+static void WriteBindingTarget(const BindingSite* site, OutputBuffer* target);
+
+static void WriteThemeSupport(void);
+static void WriteThemeSites(const TreeNode* deferred);
+static void WriteSetTheme(void);
+
+static void WriteListSupport(void);
+static void WriteListRows(const TreeNode* list);
+static void WriteListFunctions(const TreeNode* list);
+
+static void WriteViewIds(void);
+static void WriteDispatch(void);
+static void WriteFootprint(void);
+static void WriteFootprintGuard(const char* name, const char* type, size_t count, const char* previous);
 
 /***************************************************************
 ** MARK: PUBLIC FUNCTIONS
 ***************************************************************/
 
-void WriteSourceFile(const char* path, const char* moduleName, TreeNode* fileContents)
+char* GenerateSourceFile(const char* path, const char* moduleName, TreeNode* fileContents, const SourceOptions* options, size_t* size, char** chunks, size_t* chunkSizes)
 {
+    SourceBackend backend = options->backend;
+    staticLinks = options->staticLinks;
+    moduleStruct = options->moduleStruct;
 
     rootNode = fileContents;
 
-    if (outputBuffer != NULL) 
-    {
-        free(outputBuffer);
-    }
-
-    outputBufferSize = 1024 * 1024; // 1 MB
-    outputBuffer = (char*)malloc(outputBufferSize);
-    if (outputBuffer == NULL) {
-        fprintf(stderr, "Error: Could not allocate memory for output buffer\n");
-        exit(1);
-    }
+    BufferInit(&output, 64 * 1024);
 
     sprintf(moduleNameBuffer, "%s", moduleName);
     
@@ -82,32 +237,97 @@ void WriteSourceFile(const char* path, const char* moduleName, TreeNode* fileCon
 
     /* BEGIN FILE */
 
-    positionInFile = snprintf(outputBuffer, outputBufferSize, 
-"/***************************************************************\n\
-**\n\
-** NanoKit Generated Source File\n\
-**\n\
-** File         :  %s\n\
-** Module       :  %s\n\
-**\n\
-***************************************************************/\n\
-\n\
-",
-        path,
-        moduleName
-        );
+    WriteBanner(path);
 
-    positionInFile += snprintf(outputBuffer + positionInFile, outputBufferSize - positionInFile,
-        "\n\
-#include \"%s.xml.h\"\n\
-#include <stdio.h>\n\
-\n", 
-        moduleName
-    );
+    /* pooled constants are only known once every writer ran, they are spliced in here at the end */
+    size_t poolPosition = output.position;
+    supportNeeds = 0;
+
+    if (options->poolConstants)
+    {
+        PoolBegin(moduleName);
+    }
+
+    /* the unrolled backend writes the whole tree, the others only deferred subtrees and rows */
+    shareShapes = options->shareSubtrees;
+    sharedInlineBytes = 0;
+    sharedWrittenBytes = 0;
+
+    if (shareShapes)
+    {
+        CollectShapes(fileContents, backend == SOURCE_BACKEND_UNROLLED, !staticLinks);
+    }
+
+    /* the tables stay in the module source, only what is written as statements is cut */
+    if (options->chunkCount > 1)
+    {
+        CollectCuts(fileContents, options->chunkCount, backend == SOURCE_BACKEND_UNROLLED);
+    }
+
+    /* helpers are called from the chunks too once anything is cut into them */
+    exportHelpers = false;
+
+    for (size_t i = 0; i < GetCutCount(); i++)
+    {
+        exportHelpers = exportHelpers || GetCut(i)->chunk > 0;
+    }
+
+    if (GetLayoutFrameCount() > 0)
+    {
+        WriteLayoutSupport(backend == SOURCE_BACKEND_TABLE);
+    }
+
+    if (backend == SOURCE_BACKEND_TABLE)
+    {
+        WriteTableBuilder();
+        WriteTables(fileContents);
+    }
+    else if (backend == SOURCE_BACKEND_PROTOTYPE)
+    {
+        WritePrototype(fileContents);
+    }
+
+    if (GetBindingPathCount() > 0)
+    {
+        WriteBindingSupport();
+    }
+
+    if (GetThemeCount() > 0)
+    {
+        WriteThemeSupport();
+    }
+
+    if (GetListCount() > 0)
+    {
+        WriteListSupport();
+    }
+
+    if (staticLinks)
+    {
+        /* the table backends describe the hierarchy in rodata too, unrolled stores it inline */
+        WriteLinkSupport(backend != SOURCE_BACKEND_UNROLLED);
+    }
+
+    if (staticLinks && InsertsDeferred(fileContents))
+    {
+        /* a realized subtree is spliced in among its siblings through the link fields the hierarchy was stored in */
+        supportNeeds |= SUPPORT_INVALIDATE;
+    }
+
+    if (GetShapeCount() > 0)
+    {
+        WriteShapeHelpers();
+    }
+
+    if (GetCutCount() > 0)
+    {
+        WriteCutPrototypes();
+        WriteCutFunctions(0);
+    }
 
     /* BEGIN CONSTRUCTOR */
 
-    positionInFile += snprintf(outputBuffer + positionInFile, outputBufferSize - positionInFile, 
+    BufferPrintf(&output, 
 "/* Constructor */\n\
 bool %s_Create(%s_t* this)\n\
 {\n\
@@ -119,12 +339,144 @@ bool %s_Create(%s_t* this)\n\
         moduleName
     );
 
-    InitialiseNode(fileContents);
+    if (backend == SOURCE_BACKEND_TABLE)
+    {
+        if (strcmp(fileContents->className, "Window") == 0)
+        {
+            WriteWindowCreate(fileContents, &output);
+            BufferPrintf(&output, "\n");
+        }
+
+        BufferPrintf(&output,
+            "\tnkgen_BuildTable((uint8_t*)this, %s_nodes, %zu, %s_properties, %s);\n",
+            moduleName,
+            tableNodeCount,
+            moduleName,
+            staticLinks ? "false" : "true"
+        );
+
+        if (runtimeValues.position > 0)
+        {
+            BufferPrintf(&output, "\n\t/* Values that are not compile time constants */\n");
+            BufferWrite(&output, runtimeValues.data, runtimeValues.position);
+        }
+
+        BufferFree(&runtimeValues);
+
+        WriteRepeatGroups(fileContents);
+    }
+    else if (backend == SOURCE_BACKEND_PROTOTYPE)
+    {
+        BufferWrite(&output, constructorCalls.data, constructorCalls.position);
+
+        if (prototypeRangeCount > 0)
+        {
+            BufferPrintf(&output,
+                "\n\tnkgen_CopyPrototype((uint8_t*)this, (const uint8_t*)&%s_prototype, %s_ranges, %zu);\n",
+                moduleName,
+                moduleName,
+                prototypeRangeCount
+            );
+        }
+
+        if (runtimeValues.position > 0)
+        {
+            BufferPrintf(&output, "\n\t/* Values that are not compile time constants */\n");
+            BufferWrite(&output, runtimeValues.data, runtimeValues.position);
+        }
+
+        if (linkCalls.position > 0 && !staticLinks)
+        {
+            BufferPrintf(&output, "\n");
+            BufferWrite(&output, linkCalls.data, linkCalls.position);
+        }
+
+        WriteRepeatGroups(fileContents);
+
+        BufferFree(&constructorCalls);
+        BufferFree(&runtimeValues);
+        BufferFree(&linkCalls);
+    }
+    else
+    {
+        InitialiseNode(fileContents);
+    }
+
+    if (staticLinks)
+    {
+        BufferPrintf(&output, "\n\t/* View hierarchy, resolved by nkgen */\n");
+
+        if (backend == SOURCE_BACKEND_UNROLLED)
+        {
+            WriteLinkStores(fileContents, &output, true);
+        }
+        else
+        {
+            WriteLinkStores(fileContents, &output, false);
+
+            if (linkRowCount > 0)
+            {
+                BufferPrintf(&output,
+                    "\tnkgen_LinkViews((uint8_t*)this, %s_links, %zu);\n",
+                    moduleName,
+                    linkRowCount
+                );
+            }
+        }
+    }
+
+    for (size_t i = 0; i < GetListCount(); i++)
+    {
+        WriteListRows(GetList(i));
+    }
+
+    if (GetLayoutFrameCount() > 0)
+    {
+        WriteLayoutFrames(backend);
+    }
+
+    if (GetBindingPathCount() > 0)
+    {
+        BufferPrintf(&output,
+            "\n\t/* Bindings start from the values the views were built with */\n\tmemset(&this->model, 0, sizeof(this->model));\n"
+        );
+
+        WriteBindingSync(NULL);
+    }
+
+    if (GetThemeCount() > 0)
+    {
+        BufferPrintf(&output, "\n\t/* Themed fields, deferred ones are rewritten when realized */\n\tthis->theme = %s_Theme_%s;\n", moduleName, GetTheme(0)->instanceName);
+
+        if (GetThemeSiteCount() > 0)
+        {
+            BufferPrintf(&output,
+                "\tnkgen_ApplyTheme((uint8_t*)this, %s_themeResources[this->theme], %s_themeFixups, %zu);\n",
+                moduleName,
+                moduleName,
+                GetThemeSiteCount()
+            );
+        }
+    }
+
+    OutputBuffer realizeFlags;
+    BufferInit(&realizeFlags, 1024);
+    WriteRealizeFlags(fileContents, &realizeFlags);
+
+    if (realizeFlags.position > 0)
+    {
+        BufferPrintf(&output, "\n");
+        BufferWrite(&output, realizeFlags.data, realizeFlags.position);
+    }
+
+    BufferFree(&realizeFlags);
 
     /* END CONSTRUCTOR, BEGIN DESTRUCTOR */
 
-    positionInFile += snprintf(outputBuffer + positionInFile, outputBufferSize - positionInFile, 
-"}\n\
+    BufferPrintf(&output,
+"\n\
+\treturn true;\n\
+}\n\
 \n\
 /* Destructor */\n\
 void %s_Destroy(%s_t* this)\n\
@@ -136,19 +488,82 @@ void %s_Destroy(%s_t* this)\n\
         moduleName
     );
 
-    FILE *sourceFile = fopen(path, "w");
-    
-    if (!sourceFile) {
-        fprintf(stderr, "Error: Could not open source file for writing\n");
-        return;
+    if (moduleStruct)
+    {
+        WriteAccessors(fileContents);
+    }
+
+    if (GetBindingPathCount() > 0)
+    {
+        WriteBindingSetters();
+        WriteBindingApply();
+    }
+
+    if (GetThemeCount() > 0)
+    {
+        WriteSetTheme();
+    }
+
+    for (size_t i = 0; i < GetListCount(); i++)
+    {
+        WriteListFunctions(GetList(i));
+    }
+
+    if (GetViewIdCount() > 0)
+    {
+        WriteViewIds();
+    }
+
+    if (GetEventCount() > 0)
+    {
+        WriteDispatch();
+    }
+
+    if (options->footprint)
+    {
+        WriteFootprint();
+    }
+
+    WriteRealizeFunctions(fileContents);
+
+    if (options->poolConstants)
+    {
+        WritePool(poolPosition);
+        PoolEnd();
+    }
+
+    /* ahead of the pool, its constants may be typed with what the support blocks include */
+    WriteSupportPreamble(poolPosition);
+
+    char* source = BufferRelease(&output, size);
+
+    /* written even when nothing was cut into them, the build lists every chunk up front */
+    for (size_t chunk = 1; chunk < options->chunkCount; chunk++)
+    {
+        chunks[chunk - 1] = WriteChunk(options->chunkPaths[chunk - 1], chunk, options->poolConstants, &chunkSizes[chunk - 1]);
     }
 
-    fprintf(sourceFile, "%s", outputBuffer);
-    fclose(sourceFile);
+    /* the outermost calls written inline against the helpers, their prototypes and the calls themselves */
+    sharedHelperCount = GetShapeCount();
+    sharedBytesSaved = (sharedInlineBytes > sharedWrittenBytes) ? sharedInlineBytes - sharedWrittenBytes : 0;
 
-    printf("    - Wrote source file: %s\n", path);
+    ClearShapeExpansions();
+
+    ClearCuts();
+    ClearShapes();
+    shareShapes = false;
+    exportHelpers = false;
+    moduleStruct = NULL;
+
+    return source;
 }   
 
+void GetSharedSubtreeStats(size_t* helperCount, size_t* bytesSaved)
+{
+    *helperCount = sharedHelperCount;
+    *bytesSaved = sharedBytesSaved;
+}
+
 
 /***************************************************************
 ** MARK: STATIC FUNCTIONS
@@ -156,46 +571,41 @@ void %s_Destroy(%s_t* this)\n\
 
 static void InitialiseNode(TreeNode *node)
 {
-    if (strcmp(node->className, "Window") == 0)
+    const Cut* cut = (node != cutRoot) ? FindCut(node) : NULL;
+
+    if (cut)
     {
-        /* special case for window */
-        float width = 800.0f;
-        float height = 600.0f;
-        const char* title = "NanoKit Window";
+        BufferPrintf(&output, "\t%s_Build_%s(this);\n", moduleNameBuffer, node->instanceName);
+        return;
+    }
 
-        NodeProperty* property = node->properties;
-        while (property != NULL)
-        {
-            if (strcmp(property->key, "Width") == 0)
-            {
-                width = atof(property->value);
-            }
-            else if (strcmp(property->key, "Height") == 0)
-            {
-                height = atof(property->value);
-            }
-            else if (strcmp(property->key, "Title") == 0)
-            {
-                title = property->value;
-            }
+    const Shape* shape = shareShapes ? FindShape(node) : NULL;
 
-            property = property->next;
-        }
+    if (shape && node != helperRoot)
+    {
+        WriteShapeCall(shape, node);
+        return;
+    }
 
-        positionInFile += snprintf(outputBuffer + positionInFile, outputBufferSize - positionInFile,
-            "\tnkWindow_Create(&this->%s, \"%s\", %.2f, %.2f);\n",
-            node->instanceName,
-            title,
-            width,
-            height
+    if (strcmp(node->className, "Window") == 0)
+    {
+        WriteWindowCreate(node, &output);
+    }
+    else if (node->component)
+    {
+        /* generated from its own file, only its _Create is known here */
+        BufferPrintf(&output,
+            "\t%s_Create(%s);\n",
+            node->component,
+            ViewPointer(node)
         );
     }
     else
     {
-        positionInFile += snprintf(outputBuffer + positionInFile, outputBufferSize - positionInFile,
-            "\t%s(&this->%s);\n",
+        BufferPrintf(&output,
+            "\t%s(%s);\n",
             TranslateSuperConstructor(node->className),
-            node->instanceName
+            ViewPointer(node)
         );
     }
 
@@ -203,62 +613,2553 @@ static void InitialiseNode(TreeNode *node)
     NodeProperty* property = node->properties;
     while (property != NULL)
     {
+        if (IsBinding(property->value) || IsThemeResource(property->value) || IsRouted(property))
+        {
+            /* taken from the view model, the theme or the route table, see WriteBindingSync, WriteThemeSites and WriteDispatch */
+            property = property->next;
+            continue;
+        }
+
+        /* writers report unknown values against the attribute they came from */
+        DiagnosticsSetContext(node->file, property->line, property->column);
+
         bool isInherited = false;
         PropertyType type = ResolvePropertyType(node->className, property->key, &isInherited);
 
         if (isInherited)
         {
-            positionInFile += snprintf(outputBuffer + positionInFile, outputBufferSize - positionInFile,
-                "\tthis->%s.view.%s = ",
-                node->instanceName,
+            BufferPrintf(&output,
+                "\t%sview.%s = ",
+                ViewMember(node),
                 TranslatePropertyName(node->className, property->key)
             );
         }
         else
         {
-            positionInFile += snprintf(outputBuffer + positionInFile, outputBufferSize - positionInFile,
-                "\tthis->%s.%s = ",
-                node->instanceName,
+            BufferPrintf(&output,
+                "\t%s%s = ",
+                ViewMember(node),
                 TranslatePropertyName(node->className, property->key)
             );
         }
 
-        WriteValue(type, property->value, outputBuffer, outputBufferSize, &positionInFile);
+        WriteValue(type, property->value, &output);
 
         property = property->next;
     }
 
+    InitialiseChildren(node, false);
+}
+
+static void InitialiseChildren(TreeNode* node, bool repeatsOnly)
+{
+    /* repeated children are linked in a loop, so every sibling around them is linked at runtime too to keep the order */
+    bool linkChildren = !staticLinks || LinksAtRuntime(node);
+
     TreeNode* childNode = node->child;
     while (childNode != NULL)
     {
-            positionInFile += snprintf(outputBuffer + positionInFile, outputBufferSize - positionInFile,
+        if (childNode->repeatFirst)
+        {
+            childNode = WriteRepeat(node, childNode);
+            continue;
+        }
+
+        if (repeatsOnly)
+        {
+            if (childNode->component)
+            {
+                BufferPrintf(&output, "\n\t/* Initialise %s */\n", ViewLabel(childNode));
+                InitialiseNode(childNode);
+            }
+
+            /* the rest is already built by the tables, only its place among the repeated siblings is left */
+            if (!childNode->deferred)
+            {
+                WriteAddChild(node, childNode);
+            }
+
+            childNode = childNode->sibling;
+            continue;
+        }
+
+        if (childNode->deferred)
+        {
+            BufferPrintf(&output,
+                "\n\t/* %s is deferred, see %s_Realize_%s */\n",
+                childNode->instanceName,
+                moduleNameBuffer,
+                childNode->instanceName
+            );
+
+            childNode = childNode->sibling;
+            continue;
+        }
+
+            BufferPrintf(&output,
 "\n\
 \t/* Initialise %s */\n\
 ",
-            childNode->instanceName
+            ViewLabel(childNode)
         );
 
         InitialiseNode(childNode);
 
-        if (strcmp(node->className, "Window") == 0)
+        if (linkChildren)
         {
-            /* add to parent */
-            positionInFile += snprintf(outputBuffer + positionInFile, outputBufferSize - positionInFile,
-                "\n\tthis->super.rootView = (nkView_t *)&this->%s.view;\n",
-                childNode->instanceName
-            );
-        }
-        else
-        {
-            /* add to parent */
-            positionInFile += snprintf(outputBuffer + positionInFile, outputBufferSize - positionInFile,
-                "\n\tnkView_AddChildView(&this->%s.view, &this->%s.view);\n",
-                node->instanceName,
-                childNode->instanceName
-            );
+            WriteAddChild(node, childNode);
         }
         
         childNode = childNode->sibling;
     }
     
-}
\ No newline at end of file
+}
+
+static TreeNode* WriteRepeat(TreeNode* parent, TreeNode* first)
+{
+    /* the group is written once into a loop, the code size does not grow with the count */
+    OutputBuffer moduleOutput = output;
+    bool moduleStaticLinks = staticLinks;
+
+    BufferInit(&output, 4 * 1024);
+    staticLinks = false;
+
+    TreeNode* node = first;
+
+    do
+    {
+        /* no blank line straight after the opening brace */
+        BufferPrintf(&output,
+            "%s\t/* Initialise %s[index] */\n",
+            (node == first) ? "" : "\n",
+            node->instanceName
+        );
+
+        InitialiseNode(node);
+        WriteAddChild(parent, node);
+
+        node = node->sibling;
+    }
+    while (node != NULL && node->repeatCount && !node->repeatFirst);
+
+    OutputBuffer loopOutput = output;
+    output = moduleOutput;
+    staticLinks = moduleStaticLinks;
+
+    BufferPrintf(&output,
+"\n\
+\t/* Repeated %u times */\n\
+\tfor (size_t index = 0; index < %u; index++)\n\
+\t{\n\
+",
+        (unsigned)first->repeatCount,
+        (unsigned)first->repeatCount
+    );
+
+    WriteIndented(&loopOutput, &output);
+    BufferPrintf(&output, "\t}\n");
+
+    BufferFree(&loopOutput);
+
+    return node;
+}
+
+static void WriteRepeatGroups(TreeNode* node)
+{
+    /* table and prototype backends leave repeated elements and UserControls out, they are built once the rest is */
+    for (; node != NULL; node = node->sibling)
+    {
+        if (node->deferred || node->repeatCount) continue;
+
+        if (LinksAtRuntime(node))
+        {
+            BufferPrintf(&output, "\n\t/* Children of %s, linked in order around the ones built in code */", node->instanceName);
+            InitialiseChildren(node, true);
+        }
+
+        if (node->child)
+        {
+            WriteRepeatGroups(node->child);
+        }
+    }
+}
+
+static void WriteAddChild(const TreeNode* parent, const TreeNode* child)
+{
+    if (strcmp(parent->className, "Window") == 0)
+    {
+        /* add to parent */
+        BufferPrintf(&output,
+            "\n\tthis->super.rootView = (nkView_t *)&%sview;\n",
+            ViewMember(child)
+        );
+    }
+    else
+    {
+        /* add to parent */
+        BufferPrintf(&output,
+            "\n\tnkView_AddChildView(&%sview, &%sview);\n",
+            ViewMember(parent),
+            ViewMember(child)
+        );
+    }
+}
+
+static void WriteIndented(const OutputBuffer* source, OutputBuffer* target)
+{
+    /* one level deeper than the source was written, blank lines stay blank */
+    const char* line = source->data;
+    const char* end = source->data + source->position;
+
+    while (!source->failed && line < end)
+    {
+        const char* next = memchr(line, '\n', (size_t)(end - line));
+        size_t length = next ? (size_t)(next - line) + 1 : (size_t)(end - line);
+
+        if (length > 1)
+        {
+            BufferPrintf(target, "\t");
+        }
+
+        BufferWrite(target, line, length);
+        line += length;
+    }
+}
+
+static bool LinksAtRuntime(const TreeNode* node)
+{
+    /* repeated elements and UserControls are built in code rather than by the tables, their siblings are linked around them */
+    return node->runtimeLinks;
+}
+
+static const char* ViewPointer(const TreeNode* node)
+{
+    char* reference = references[nextReference++ % 4];
+    size_t index = 0;
+
+    if (helperRoot && FindPreorder(helperRoot, node, &index))
+    {
+        snprintf(reference, sizeof(references[0]), "n%zu", index);
+        CountParameter(index, reference);
+    }
+    else
+    {
+        snprintf(reference, sizeof(references[0]), "&%s%s%s", instanceBase, node->instanceName, node->repeatCount ? "[index]" : "");
+    }
+
+    return reference;
+}
+
+static const char* ViewMember(const TreeNode* node)
+{
+    char* reference = references[nextReference++ % 4];
+    size_t index = 0;
+
+    /* a UserControl's views hang off the super member of its struct */
+    if (helperRoot && FindPreorder(helperRoot, node, &index))
+    {
+        snprintf(reference, sizeof(references[0]), "n%zu->%s", index, node->component ? "super." : "");
+        CountParameter(index, reference);
+    }
+    else
+    {
+        snprintf(reference, sizeof(references[0]), "%s%s%s.%s", instanceBase, node->instanceName, node->repeatCount ? "[index]" : "", node->component ? "super." : "");
+    }
+
+    return reference;
+}
+
+static const char* ViewLabel(const TreeNode* node)
+{
+    /* the name used in comments, helpers only know their parameters */
+    const char* pointer = ViewPointer(node);
+
+    if (pointer[0] == '&') return pointer + 1 + strlen(instanceBase);
+
+    /* counted as a pointer by ViewPointer, inline it is the bare name */
+    if (helperExpansion)
+    {
+        size_t index = strtoul(pointer + 1, NULL, 10);
+
+        helperExpansion->references[index]--;
+        helperExpansion->labels[index]++;
+    }
+
+    return pointer;
+}
+
+static void CountParameter(size_t index, const char* reference)
+{
+    if (!helperExpansion) return;
+
+    /* "super." is written the same inline, only the part naming the view differs */
+    helperExpansion->references[index]++;
+    helperParameterBytes += strcspn(reference, "-") + (strchr(reference, '-') ? strlen("->") : 0);
+}
+
+static bool FindPreorder(const TreeNode* root, const TreeNode* node, size_t* index)
+{
+    if (root == node) return true;
+
+    (*index)++;
+
+    for (const TreeNode* child = root->child; child != NULL; child = child->sibling)
+    {
+        if (FindPreorder(child, node, index)) return true;
+    }
+
+    return false;
+}
+
+static void WriteShapeHelpers(void)
+{
+    shapeExpansions = (ShapeExpansion*)calloc(GetShapeCount(), sizeof(ShapeExpansion));
+
+    /* shortest first, a helper only calls helpers of smaller subtrees */
+    for (size_t i = 0; i < GetShapeCount(); i++)
+    {
+        const Shape* shape = GetShape(i);
+        size_t start = output.position;
+
+        BufferPrintf(&output, "/* %zu identical subtrees, views in pre-order */\n", shape->uses);
+        WriteShapeSignature(shape, false);
+
+        helperRoot = shape->node;
+        helperExpansion = NULL;
+        helperParameterBytes = 0;
+        helperCallBytes = 0;
+
+        if (shapeExpansions)
+        {
+            helperExpansion = &shapeExpansions[i];
+            helperExpansion->references = (size_t*)calloc(shape->nodeCount, sizeof(size_t));
+            helperExpansion->labels = (size_t*)calloc(shape->nodeCount, sizeof(size_t));
+
+            /* only the statistics are lost, the helpers are written all the same */
+            if (!helperExpansion->references || !helperExpansion->labels)
+            {
+                ClearShapeExpansions();
+                helperExpansion = NULL;
+            }
+        }
+
+        size_t body = output.position;
+        InitialiseNode((TreeNode*)shape->node);
+
+        /* nested calls were replaced by their expansions, parameters by the members they stand for */
+        if (helperExpansion)
+        {
+            helperExpansion->fixedBytes += output.position - body - helperParameterBytes - helperCallBytes;
+        }
+
+        helperRoot = NULL;
+        helperExpansion = NULL;
+
+        BufferPrintf(&output, "}\n\n");
+
+        sharedWrittenBytes += output.position - start;
+    }
+}
+
+static void WriteShapeSignature(const Shape* shape, bool prototype)
+{
+    /* static unless cut functions in other chunks call it */
+    BufferPrintf(&output, "%svoid %s_init_%08x(", exportHelpers ? "" : "static ", moduleNameBuffer, (unsigned)shape->hash);
+
+    for (size_t index = 0; index < shape->nodeCount; index++)
+    {
+        const TreeNode* node = shape->node;
+        size_t remaining = index;
+
+        /* walk to the index-th view in pre-order */
+        while (remaining > 0)
+        {
+            if (node->child)
+            {
+                node = node->child;
+            }
+            else
+            {
+                while (!node->sibling) node = node->parent;
+                node = node->sibling;
+            }
+
+            remaining--;
+        }
+
+        BufferPrintf(&output, "%s%s* n%zu", (index == 0) ? "" : ", ", TranslateClassName(node->className), index);
+    }
+
+    BufferPrintf(&output, prototype ? ");\n" : ")\n{\n");
+}
+
+static void WriteShapeCall(const Shape* shape, const TreeNode* node)
+{
+    bool first = true;
+
+    size_t start = output.position;
+
+    /* the arguments are not references the inline subtree would have written */
+    ShapeExpansion* expansion = helperExpansion;
+    helperExpansion = NULL;
+
+    BufferPrintf(&output, "\t%s_init_%08x(", moduleNameBuffer, (unsigned)shape->hash);
+    WriteShapeArguments(node, &first);
+    BufferPrintf(&output, ");\n");
+
+    helperExpansion = expansion;
+
+    if (!shapeExpansions) return;
+
+    const ShapeExpansion* called = &shapeExpansions[shape->index];
+    size_t index = 0;
+    size_t memberBytes = ExpandShapeCall(called, node, &index);
+
+    /* calls inside a helper are expanded with it, only the outermost ones count towards the module */
+    if (helperRoot)
+    {
+        if (helperExpansion)
+        {
+            helperExpansion->fixedBytes += called->fixedBytes;
+            helperCallBytes += output.position - start;
+        }
+    }
+    else
+    {
+        sharedInlineBytes += called->fixedBytes + memberBytes;
+        sharedWrittenBytes += output.position - start;
+    }
+}
+
+static size_t ExpandShapeCall(const ShapeExpansion* expansion, const TreeNode* node, size_t* index)
+{
+    size_t references = expansion->references[*index];
+    size_t labels = expansion->labels[*index];
+    size_t bytes = 0;
+
+    (*index)++;
+
+    if (helperRoot)
+    {
+        /* within a helper the references move on to its own parameters */
+        size_t parameter = 0;
+
+        if (helperExpansion && FindPreorder(helperRoot, node, &parameter))
+        {
+            helperExpansion->references[parameter] += references;
+            helperExpansion->labels[parameter] += labels;
+        }
+    }
+    else
+    {
+        /* &this->name and this->name. as pointer and member, the name alone in comments */
+        size_t member = strlen(instanceBase) + strlen(node->instanceName) + (node->repeatCount ? strlen("[index]") : 0);
+        bytes = references * (member + 1) + labels * (member - strlen(instanceBase));
+    }
+
+    for (const TreeNode* child = node->child; child != NULL; child = child->sibling)
+    {
+        bytes += ExpandShapeCall(expansion, child, index);
+    }
+
+    return bytes;
+}
+
+static void ClearShapeExpansions(void)
+{
+    for (size_t i = 0; shapeExpansions && i < GetShapeCount(); i++)
+    {
+        free(shapeExpansions[i].references);
+        free(shapeExpansions[i].labels);
+    }
+
+    free(shapeExpansions);
+    shapeExpansions = NULL;
+}
+
+static void WriteShapeArguments(const TreeNode* node, bool* first)
+{
+    BufferPrintf(&output, "%s%s", *first ? "" : ", ", ViewPointer(node));
+    *first = false;
+
+    for (const TreeNode* child = node->child; child != NULL; child = child->sibling)
+    {
+        WriteShapeArguments(child, first);
+    }
+}
+
+static void WriteWindowCreate(TreeNode* node, OutputBuffer* target)
+{
+    /* special case for window */
+    float width = 800.0f;
+    float height = 600.0f;
+    const char* title = "NanoKit Window";
+
+    NodeProperty* property = node->properties;
+    while (property != NULL)
+    {
+        if (IsBinding(property->value))
+        {
+            /* bound window properties keep the defaults until _Apply */
+        }
+        else if (strcmp(property->key, "Width") == 0)
+        {
+            width = atof(property->value);
+        }
+        else if (strcmp(property->key, "Height") == 0)
+        {
+            height = atof(property->value);
+        }
+        else if (strcmp(property->key, "Title") == 0)
+        {
+            title = property->value;
+        }
+
+        property = property->next;
+    }
+
+    const char* pooledTitle = PoolString(title);
+
+    if (pooledTitle)
+    {
+        BufferPrintf(target,
+            "\tnkWindow_Create(&this->%s, %s, %.2f, %.2f);\n",
+            node->instanceName,
+            pooledTitle,
+            width,
+            height
+        );
+        return;
+    }
+
+    BufferPrintf(target,
+        "\tnkWindow_Create(&this->%s, \"%s\", %.2f, %.2f);\n",
+        node->instanceName,
+        title,
+        width,
+        height
+    );
+}
+
+static void WriteBanner(const char* path)
+{
+    BufferPrintf(&output, 
+"/***************************************************************\n\
+**\n\
+** NanoKit Generated Source File\n\
+**\n\
+** File         :  %s\n\
+** Module       :  %s\n\
+**\n\
+***************************************************************/\n\
+\n\
+",
+        path,
+        moduleNameBuffer
+        );
+
+    BufferPrintf(&output,
+        "\n\
+#include \"%s.xml.h\"\n\
+#include <stdio.h>\n\
+\n", 
+        moduleNameBuffer
+    );
+
+    if (moduleStruct)
+    {
+        BufferPrintf(&output, "%s", moduleStruct);
+    }
+}
+
+static void WriteAccessors(TreeNode* node)
+{
+    if (node == rootNode)
+    {
+        BufferPrintf(&output,
+"\n\
+/* Opaque Module */\n\
+size_t %s_Size(void)\n\
+{\n\
+\treturn sizeof(%s_t);\n\
+}\n\
+\n\
+%s* %s_GetRoot(%s_t* this)\n\
+{\n\
+\treturn &this->super;\n\
+}\n\
+",
+            moduleNameBuffer,
+            moduleNameBuffer,
+            TranslateClassName(node->className),
+            moduleNameBuffer,
+            moduleNameBuffer
+        );
+
+        node = node->child;
+    }
+
+    for (; node != NULL; node = node->sibling)
+    {
+        if (node->named)
+        {
+            BufferPrintf(&output,
+                "\n%s%s* %s_Get_%s(%s_t* this%s)\n{\n\treturn &this->%s%s;\n}\n",
+                node->component ? node->component : TranslateClassName(node->className),
+                node->component ? "_t" : "",
+                moduleNameBuffer,
+                node->instanceName,
+                moduleNameBuffer,
+                node->repeatCount ? ", size_t index" : "",
+                node->instanceName,
+                node->repeatCount ? "[index]" : ""
+            );
+        }
+
+        WriteAccessors(node->child);
+    }
+}
+
+static void WriteCutFunctions(size_t chunk)
+{
+    /* only called from _Create or a Realize function, those in the module source stay static */
+    for (size_t i = 0; i < GetCutCount(); i++)
+    {
+        const Cut* cut = GetCut(i);
+
+        if (cut->chunk != chunk) continue;
+
+        BufferPrintf(&output,
+            "/* %s and its subtree */\n%svoid %s_Build_%s(%s_t* this)\n{\n",
+            cut->node->instanceName,
+            (chunk == 0) ? "static " : "",
+            moduleNameBuffer,
+            cut->node->instanceName,
+            moduleNameBuffer
+        );
+
+        cutRoot = cut->node;
+        InitialiseNode((TreeNode*)cut->node);
+        cutRoot = NULL;
+
+        BufferPrintf(&output, "}\n\n");
+    }
+}
+
+static void WriteCutPrototypes(void)
+{
+    bool first = true;
+
+    for (size_t i = 0; i < GetCutCount(); i++)
+    {
+        const Cut* cut = GetCut(i);
+
+        if (cut->chunk == 0) continue;
+
+        if (first)
+        {
+            BufferPrintf(&output, "/* Subtrees built in the other chunks of the module */\n");
+            first = false;
+        }
+
+        BufferPrintf(&output, "void %s_Build_%s(%s_t* this);\n", moduleNameBuffer, cut->node->instanceName, moduleNameBuffer);
+    }
+
+    if (!first)
+    {
+        BufferPrintf(&output, "\n");
+    }
+}
+
+static char* WriteChunk(const char* path, size_t chunk, bool poolConstants, size_t* size)
+{
+    BufferInit(&output, 64 * 1024);
+
+    WriteBanner(path);
+
+    size_t poolPosition = output.position;
+
+    /* every chunk is its own translation unit, so its own pool */
+    if (poolConstants)
+    {
+        char poolName[300];
+        snprintf(poolName, sizeof(poolName), "%s_%zu", moduleNameBuffer, chunk);
+        PoolBegin(poolName);
+    }
+
+    if (exportHelpers && GetShapeCount() > 0)
+    {
+        size_t start = output.position;
+
+        BufferPrintf(&output, "/* Shared subtree helpers, defined in the module source */\n");
+
+        for (size_t i = 0; i < GetShapeCount(); i++)
+        {
+            WriteShapeSignature(GetShape(i), true);
+        }
+
+        BufferPrintf(&output, "\n");
+
+        sharedWrittenBytes += output.position - start;
+    }
+
+    size_t position = output.position;
+
+    WriteCutFunctions(chunk);
+
+    if (output.position == position)
+    {
+        BufferPrintf(&output, "/* Nothing was cut into this chunk */\n");
+    }
+
+    if (poolConstants)
+    {
+        WritePool(poolPosition);
+        PoolEnd();
+    }
+
+    return BufferRelease(&output, size);
+}
+
+static void WritePool(size_t position)
+{
+    if (output.failed) return;
+
+    OutputBuffer pooled;
+    BufferInit(&pooled, output.position + 4 * 1024);
+
+    BufferWrite(&pooled, output.data, position);
+    PoolWrite(&pooled);
+    BufferWrite(&pooled, output.data + position, output.position - position);
+
+    BufferFree(&output);
+    output = pooled;
+}
+
+static void WriteSupportPreamble(size_t position)
+{
+    if (output.failed || supportNeeds == 0) return;
+
+    OutputBuffer preamble;
+    BufferInit(&preamble, output.position + 1024);
+
+    BufferWrite(&preamble, output.data, position);
+
+    if (supportNeeds & SUPPORT_STDBOOL) BufferPrintf(&preamble, "#include <stdbool.h>\n");
+    if (supportNeeds & SUPPORT_STDDEF) BufferPrintf(&preamble, "#include <stddef.h>\n");
+    if (supportNeeds & SUPPORT_STDINT) BufferPrintf(&preamble, "#include <stdint.h>\n");
+    if (supportNeeds & SUPPORT_STRING) BufferPrintf(&preamble, "#include <string.h>\n");
+
+    if (supportNeeds & (SUPPORT_STDBOOL | SUPPORT_STDDEF | SUPPORT_STDINT | SUPPORT_STRING))
+    {
+        BufferPrintf(&preamble, "\n");
+    }
+
+    /* called for every view that changed after construction, a NanoKit build can hook layout invalidation here */
+    if (supportNeeds & SUPPORT_INVALIDATE)
+    {
+        BufferPrintf(&preamble,
+"#ifndef NKGEN_INVALIDATE_VIEW\n\
+#define NKGEN_INVALIDATE_VIEW(view) ((void)(view))\n\
+#endif\n\
+\n"
+        );
+    }
+
+    BufferWrite(&preamble, output.data + position, output.position - position);
+
+    BufferFree(&output);
+    output = preamble;
+}
+
+static void WriteTableBuilder(void)
+{
+    supportNeeds |= SUPPORT_STDBOOL | SUPPORT_STDDEF | SUPPORT_STDINT;
+
+    /* guarded so modules amalgamated into one translation unit share a single builder */
+    BufferPrintf(&output,
+"#ifndef NKGEN_TABLE_BUILDER\n\
+#define NKGEN_TABLE_BUILDER\n\
+\n\
+#define NKGEN_NO_PARENT (0xFFFFFFFFu)\n\
+#define NKGEN_CLASS_WINDOW (%zu)\n\
+\n\
+typedef union\n\
+{\n\
+\tconst char* string;\n\
+\tfloat number;\n\
+\tint enumeration;\n\
+\tvoid (*callback)(void);\n\
+} nkgenValue_t;\n\
+\n\
+typedef struct\n\
+{\n\
+\tuint32_t offset;\n\
+\tuint32_t type;\n\
+\tnkgenValue_t value;\n\
+} nkgenProperty_t;\n\
+\n\
+typedef struct\n\
+{\n\
+\tuint32_t offset;\n\
+\tuint32_t viewOffset;\n\
+\tuint32_t parent;\n\
+\tuint16_t classId;\n\
+\tuint16_t propertyCount;\n\
+} nkgenNode_t;\n\
+\n\
+/* Builds the view tree from descriptors in pre-order, each node's properties follow the previous node's */\n\
+static void nkgen_BuildTable(uint8_t* base, const nkgenNode_t* nodes, size_t nodeCount, const nkgenProperty_t* properties, bool linkViews)\n\
+{\n\
+\tfor (size_t i = 0; i < nodeCount; i++)\n\
+\t{\n\
+\t\tconst nkgenNode_t* node = &nodes[i];\n\
+\t\tvoid* member = base + node->offset;\n\
+\n\
+\t\tswitch (node->classId)\n\
+\t\t{\n",
+        GetClassIndex("Window")
+    );
+
+    for (size_t i = 0; i < GetClassCount(); i++)
+    {
+        const char* className = GetClassMarkupName(i);
+
+        if (strcmp(className, "Window") == 0) continue; /* created by _Create with its title and size */
+        if (strcmp(className, "UserControl") == 0) continue; /* every component has its own _Create */
+
+        BufferPrintf(&output,
+            "\t\t\tcase %zu: %s((%s*)member); break;\n",
+            i,
+            TranslateSuperConstructor(className),
+            TranslateClassName(className)
+        );
+    }
+
+    BufferPrintf(&output,
+"\t\t\tdefault: break;\n\
+\t\t}\n\
+\n\
+\t\tfor (uint16_t p = 0; p < node->propertyCount; p++, properties++)\n\
+\t\t{\n\
+\t\t\tvoid* field = base + properties->offset;\n\
+\n\
+\t\t\tswitch (properties->type)\n\
+\t\t\t{\n"
+    );
+
+    for (size_t type = 0; type < PROPERTY_TYPE_COUNT; type++)
+    {
+        const char* member = GetConstantMember((PropertyType)type);
+
+        if (!member || !IsPropertyTypeUsed((PropertyType)type)) continue;
+
+        BufferPrintf(&output,
+            "\t\t\t\tcase %zu: *(%s*)field = (%s)properties->value.%s; break;\n",
+            type,
+            GetTypeCodeName((PropertyType)type),
+            GetTypeCodeName((PropertyType)type),
+            member
+        );
+    }
+
+    BufferPrintf(&output,
+"\t\t\t\tdefault: break;\n\
+\t\t\t}\n\
+\t\t}\n\
+\n\
+\t\tif (!linkViews || node->parent == NKGEN_NO_PARENT) continue;\n\
+\n\
+\t\tconst nkgenNode_t* parent = &nodes[node->parent];\n\
+\n\
+\t\tif (parent->classId == NKGEN_CLASS_WINDOW)\n\
+\t\t{\n\
+\t\t\t((nkWindow_t*)(base + parent->offset))->rootView = (nkView_t*)(base + node->viewOffset);\n\
+\t\t}\n\
+\t\telse\n\
+\t\t{\n\
+\t\t\tnkView_AddChildView((nkView_t*)(base + parent->viewOffset), (nkView_t*)(base + node->viewOffset));\n\
+\t\t}\n\
+\t}\n\
+}\n\
+\n\
+#endif /* NKGEN_TABLE_BUILDER */\n\
+\n"
+    );
+}
+
+static void WriteTables(TreeNode* node)
+{
+    BufferInit(&propertyTable, 16 * 1024);
+    BufferInit(&runtimeValues, 4 * 1024);
+    tableNodeCount = 0;
+
+    BufferPrintf(&output,
+        "static const nkgenNode_t %s_nodes[] = {\n",
+        moduleNameBuffer
+    );
+
+    WriteTableNode(node, (size_t)-1);
+
+    BufferPrintf(&output,
+        "};\n\nstatic const nkgenProperty_t %s_properties[] = {\n",
+        moduleNameBuffer
+    );
+
+    if (propertyTable.position > 0)
+    {
+        BufferWrite(&output, propertyTable.data, propertyTable.position);
+    }
+    else
+    {
+        BufferPrintf(&output, "\t{ 0 }\n"); /* arrays cannot be empty */
+    }
+
+    BufferPrintf(&output, "};\n\n");
+
+    BufferFree(&propertyTable);
+}
+
+static void WriteTableNode(TreeNode* node, size_t parentIndex)
+{
+    /* siblings are walked in a loop, only depth recurses */
+    for (; node != NULL; node = node->sibling)
+    {
+        if (node->deferred) continue; /* built by its Realize function */
+        if (node->repeatCount) continue; /* built by its loop, see WriteRepeatGroups */
+        if (node->component) continue; /* built by its own _Create, see WriteRepeatGroups */
+
+        size_t index = tableNodeCount++;
+        bool isWindow = strcmp(node->className, "Window") == 0;
+
+        if (isWindow && parentIndex != (size_t)-1)
+        {
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, node->line, node->column, "Window can only be the root element with the table backend");
+        }
+
+        size_t propertyCount = 0;
+
+        for (NodeProperty* property = node->properties; property != NULL; property = property->next)
+        {
+            if (IsBinding(property->value) || IsThemeResource(property->value) || IsRouted(property)) continue; /* taken from the view model, the theme or the route table */
+
+            DiagnosticsSetContext(node->file, property->line, property->column);
+
+            bool isInherited = false;
+            PropertyType type = ResolvePropertyType(node->className, property->key, &isInherited);
+            const char* fieldName = TranslatePropertyName(node->className, property->key);
+
+            if (GetConstantMember(type))
+            {
+                BufferPrintf(&propertyTable,
+                    "\t{ offsetof(%s_t, %s%s.%s), %d, ",
+                    moduleNameBuffer,
+                    node->instanceName,
+                    isInherited ? ".view" : "",
+                    fieldName,
+                    (int)type
+                );
+
+                WriteConstant(type, property->value, &propertyTable);
+
+                BufferPrintf(&propertyTable, " },\n");
+
+                propertyCount++;
+            }
+            else
+            {
+                /* assigned after the builder has run the constructors */
+                BufferPrintf(&runtimeValues,
+                    "\tthis->%s%s.%s = ",
+                    node->instanceName,
+                    isInherited ? ".view" : "",
+                    fieldName
+                );
+
+                WriteValue(type, property->value, &runtimeValues);
+            }
+        }
+
+        BufferPrintf(&output, "\t{ offsetof(%s_t, %s), ", moduleNameBuffer, node->instanceName);
+
+        if (isWindow)
+        {
+            BufferPrintf(&output, "0, ");
+        }
+        else
+        {
+            BufferPrintf(&output, "offsetof(%s_t, %s.view), ", moduleNameBuffer, node->instanceName);
+        }
+
+        if (parentIndex == (size_t)-1 || LinksAtRuntime(node->parent))
+        {
+            /* a parent with repeated children links them all in order after the build */
+            BufferPrintf(&output, "NKGEN_NO_PARENT, ");
+        }
+        else
+        {
+            BufferPrintf(&output, "%zu, ", parentIndex);
+        }
+
+        BufferPrintf(&output,
+            "%zu, %zu }, /* %s %s */\n",
+            GetClassIndex(node->className),
+            propertyCount,
+            node->className,
+            node->instanceName
+        );
+
+        if (node->child)
+        {
+            WriteTableNode(node->child, index);
+        }
+    }
+}
+
+static void WritePrototype(TreeNode* node)
+{
+    BufferInit(&prototypeFields, 16 * 1024);
+    BufferInit(&prototypeRanges, 16 * 1024);
+    BufferInit(&constructorCalls, 16 * 1024);
+    BufferInit(&runtimeValues, 4 * 1024);
+    BufferInit(&linkCalls, 16 * 1024);
+    prototypeRangeCount = 0;
+
+    WritePrototypeNode(node);
+
+    /* precomputed frames are constants too, subtree roots only have their size fixed */
+    for (size_t i = 0; i < GetLayoutFrameCount(); i++)
+    {
+        const LayoutFrame* frame = GetLayoutFrame(i);
+        const char* name = frame->node->instanceName;
+
+        if (frame->sizeOnly)
+        {
+            BufferPrintf(&prototypeFields, "\t.%s.view.NKGEN_VIEW_FRAME.width = ", name);
+            WriteFloat(frame->width, &prototypeFields);
+            BufferPrintf(&prototypeFields, ",\n\t.%s.view.NKGEN_VIEW_FRAME.height = ", name);
+            WriteFloat(frame->height, &prototypeFields);
+            BufferPrintf(&prototypeFields, ",\n");
+
+            BufferPrintf(&prototypeRanges,
+                "\t{ offsetof(%s_t, %s.view.NKGEN_VIEW_FRAME.width), sizeof(float) },\n\t{ offsetof(%s_t, %s.view.NKGEN_VIEW_FRAME.height), sizeof(float) },\n",
+                moduleNameBuffer,
+                name,
+                moduleNameBuffer,
+                name
+            );
+
+            prototypeRangeCount += 2;
+        }
+        else
+        {
+            BufferPrintf(&prototypeFields, "\t.%s.view.NKGEN_VIEW_FRAME = ", name);
+            WriteRect(frame, false, &prototypeFields);
+            BufferPrintf(&prototypeFields, ",\n");
+
+            BufferPrintf(&prototypeRanges,
+                "\t{ offsetof(%s_t, %s.view.NKGEN_VIEW_FRAME), sizeof(nkRect_t) },\n",
+                moduleNameBuffer,
+                name
+            );
+
+            prototypeRangeCount++;
+        }
+    }
+
+    if (prototypeRangeCount > 0)
+    {
+        /* constructors run first and set fields nkgen cannot see, so constants are copied over them range by range,
+           only the compiler knows the offsets, ranges that touch are merged into one memcpy while copying */
+        supportNeeds |= SUPPORT_STDDEF | SUPPORT_STDINT | SUPPORT_STRING;
+
+        BufferPrintf(&output,
+"#ifndef NKGEN_PROTOTYPE_COPY\n\
+#define NKGEN_PROTOTYPE_COPY\n\
+\n\
+typedef struct\n\
+{\n\
+\tuint32_t offset;\n\
+\tuint32_t size;\n\
+} nkgenRange_t;\n\
+\n\
+static void nkgen_CopyPrototype(uint8_t* base, const uint8_t* prototype, const nkgenRange_t* ranges, size_t rangeCount)\n\
+{\n\
+\tfor (size_t i = 0; i < rangeCount; )\n\
+\t{\n\
+\t\tuint32_t offset = ranges[i].offset;\n\
+\t\tuint32_t end = offset + ranges[i].size;\n\
+\n\
+\t\tfor (i++; i < rangeCount && ranges[i].offset == end; i++)\n\
+\t\t{\n\
+\t\t\tend += ranges[i].size;\n\
+\t\t}\n\
+\n\
+\t\tmemcpy(base + offset, prototype + offset, end - offset);\n\
+\t}\n\
+}\n\
+\n\
+#endif /* NKGEN_PROTOTYPE_COPY */\n\
+\n\
+static const %s_t %s_prototype = {\n",
+            moduleNameBuffer,
+            moduleNameBuffer
+        );
+
+        BufferWrite(&output, prototypeFields.data, prototypeFields.position);
+
+        BufferPrintf(&output,
+            "};\n\nstatic const nkgenRange_t %s_ranges[] = {\n",
+            moduleNameBuffer
+        );
+
+        BufferWrite(&output, prototypeRanges.data, prototypeRanges.position);
+
+        BufferPrintf(&output, "};\n\n");
+    }
+
+    BufferFree(&prototypeFields);
+    BufferFree(&prototypeRanges);
+
+    free(nodeFields);
+    nodeFields = NULL;
+    nodeFieldCapacity = 0;
+}
+
+static void WritePrototypeNode(TreeNode* node)
+{
+    /* siblings are walked in a loop, only depth recurses */
+    for (; node != NULL; node = node->sibling)
+    {
+        if (node->deferred) continue; /* built by its Realize function */
+        if (node->repeatCount) continue; /* built by its loop, see WriteRepeatGroups */
+        if (node->component) continue; /* built by its own _Create, see WriteRepeatGroups */
+
+        if (strcmp(node->className, "Window") == 0)
+        {
+            WriteWindowCreate(node, &constructorCalls);
+        }
+        else
+        {
+            BufferPrintf(&constructorCalls,
+                "\t%s(&this->%s);\n",
+                TranslateSuperConstructor(node->className),
+                node->instanceName
+            );
+        }
+
+        size_t fieldCount = 0;
+
+        for (NodeProperty* property = node->properties; property != NULL; property = property->next)
+        {
+            if (IsBinding(property->value) || IsThemeResource(property->value) || IsRouted(property)) continue; /* taken from the view model, the theme or the route table */
+
+            DiagnosticsSetContext(node->file, property->line, property->column);
+
+            bool isInherited = false;
+            PropertyType type = ResolvePropertyType(node->className, property->key, &isInherited);
+            const char* fieldName = TranslatePropertyName(node->className, property->key);
+
+            if (!GetConstantMember(type))
+            {
+                BufferPrintf(&runtimeValues,
+                    "\tthis->%s%s.%s = ",
+                    node->instanceName,
+                    isInherited ? ".view" : "",
+                    fieldName
+                );
+
+                WriteValue(type, property->value, &runtimeValues);
+            }
+            else if (!IsOverridden(node, property))
+            {
+                BufferPrintf(&prototypeFields,
+                    "\t.%s%s.%s = ",
+                    node->instanceName,
+                    isInherited ? ".view" : "",
+                    fieldName
+                );
+
+                WriteExpression(type, property->value, &prototypeFields);
+
+                BufferPrintf(&prototypeFields, ",\n");
+
+                if (fieldCount == nodeFieldCapacity)
+                {
+                    size_t capacity = nodeFieldCapacity ? nodeFieldCapacity * 2 : 16;
+                    PrototypeField* grown = (PrototypeField*)realloc(nodeFields, capacity * sizeof(PrototypeField));
+
+                    if (!grown) continue;
+
+                    nodeFields = grown;
+                    nodeFieldCapacity = capacity;
+                }
+
+                nodeFields[fieldCount++] = (PrototypeField){ GetPropertyOrder(node->className, property->key), fieldName, isInherited };
+            }
+        }
+
+        /* markup order is arbitrary, declaration order lets the copy merge neighbouring fields */
+        if (fieldCount > 1) qsort(nodeFields, fieldCount, sizeof(PrototypeField), ComparePrototypeFields);
+
+        for (size_t i = 0; i < fieldCount; i++)
+        {
+            BufferPrintf(&prototypeRanges,
+                "\t{ offsetof(%s_t, %s%s.%s), sizeof(((%s_t*)0)->%s%s.%s) },\n",
+                moduleNameBuffer,
+                node->instanceName,
+                nodeFields[i].isInherited ? ".view" : "",
+                nodeFields[i].fieldName,
+                moduleNameBuffer,
+                node->instanceName,
+                nodeFields[i].isInherited ? ".view" : "",
+                nodeFields[i].fieldName
+            );
+        }
+
+        prototypeRangeCount += fieldCount;
+
+        /* a parent with repeated children links them all in order after the build */
+        for (TreeNode* childNode = LinksAtRuntime(node) ? NULL : NextEager(node->child); childNode != NULL; childNode = NextEager(childNode->sibling))
+        {
+            if (strcmp(node->className, "Window") == 0)
+            {
+                BufferPrintf(&linkCalls,
+                    "\tthis->%s.rootView = (nkView_t *)&this->%s.view;\n",
+                    node->instanceName,
+                    childNode->instanceName
+                );
+            }
+            else
+            {
+                BufferPrintf(&linkCalls,
+                    "\tnkView_AddChildView(&this->%s.view, &this->%s.view);\n",
+                    node->instanceName,
+                    childNode->instanceName
+                );
+            }
+        }
+
+        if (node->child)
+        {
+            WritePrototypeNode(node->child);
+        }
+    }
+}
+
+static int ComparePrototypeFields(const void* a, const void* b)
+{
+    size_t orderA = ((const PrototypeField*)a)->order;
+    size_t orderB = ((const PrototypeField*)b)->order;
+
+    return (orderA < orderB) ? -1 : (orderA > orderB) ? 1 : 0;
+}
+
+static bool IsOverridden(const TreeNode* node, const NodeProperty* property)
+{
+    /* a later attribute writing the same field wins, as it does in the unrolled stores */
+    const char* fieldName = TranslatePropertyName(node->className, property->key);
+
+    for (const NodeProperty* later = property->next; later != NULL; later = later->next)
+    {
+        if (IsBinding(later->value) || IsThemeResource(later->value) || IsRouted(later)) continue; /* bindings and themes are applied after the stores, routes are not stored */
+
+        if (strcmp(TranslatePropertyName(node->className, later->key), fieldName) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void WriteLinkSupport(bool withTable)
+{
+    /* NanoKit keeps the hierarchy in these nkView_t fields, a build with different names overrides them */
+    BufferPrintf(&output,
+"#ifndef NKGEN_VIEW_PARENT\n\
+#define NKGEN_VIEW_PARENT parent\n\
+#endif\n\
+\n\
+#ifndef NKGEN_VIEW_CHILD\n\
+#define NKGEN_VIEW_CHILD child\n\
+#endif\n\
+\n\
+#ifndef NKGEN_VIEW_SIBLING\n\
+#define NKGEN_VIEW_SIBLING sibling\n\
+#endif\n\
+\n"
+    );
+
+    if (!withTable) return;
+
+    /* a hierarchy linked entirely at runtime leaves no rows, the table and the helper are then left out */
+    OutputBuffer rows;
+    BufferInit(&rows, 1024);
+
+    linkRowCount = 0;
+    WriteLinkRows(rootNode, &rows);
+
+    if (linkRowCount == 0)
+    {
+        BufferFree(&rows);
+        return;
+    }
+
+    supportNeeds |= SUPPORT_STDDEF | SUPPORT_STDINT;
+
+    BufferPrintf(&output,
+"#ifndef NKGEN_STATIC_LINKS\n\
+#define NKGEN_STATIC_LINKS\n\
+\n\
+#define NKGEN_NO_VIEW (0xFFFFFFFFu)\n\
+\n\
+typedef struct\n\
+{\n\
+\tuint32_t view;\n\
+\tuint32_t parent;\n\
+\tuint32_t child;\n\
+\tuint32_t sibling;\n\
+} nkgenLink_t;\n\
+\n\
+/* Offsets of nkView_t members within the module struct, NKGEN_NO_VIEW leaves the field as constructed */\n\
+static void nkgen_LinkViews(uint8_t* base, const nkgenLink_t* links, size_t linkCount)\n\
+{\n\
+\tfor (size_t i = 0; i < linkCount; i++)\n\
+\t{\n\
+\t\tnkView_t* view = (nkView_t*)(base + links[i].view);\n\
+\n\
+\t\tif (links[i].parent != NKGEN_NO_VIEW) view->NKGEN_VIEW_PARENT = (nkView_t*)(base + links[i].parent);\n\
+\t\tif (links[i].child != NKGEN_NO_VIEW) view->NKGEN_VIEW_CHILD = (nkView_t*)(base + links[i].child);\n\
+\t\tif (links[i].sibling != NKGEN_NO_VIEW) view->NKGEN_VIEW_SIBLING = (nkView_t*)(base + links[i].sibling);\n\
+\t}\n\
+}\n\
+\n\
+#endif /* NKGEN_STATIC_LINKS */\n\
+\n\
+static const nkgenLink_t %s_links[] = {\n",
+        moduleNameBuffer
+    );
+
+    BufferWrite(&output, rows.data, rows.position);
+    BufferFree(&rows);
+
+    BufferPrintf(&output, "};\n\n");
+}
+
+static void WriteLinkRows(TreeNode* node, OutputBuffer* target)
+{
+    bool isWindow = strcmp(node->className, "Window") == 0;
+    bool hasViewParent = node->parent && strcmp(node->parent->className, "Window") != 0 && !LinksAtRuntime(node->parent);
+
+    /* children of a parent with repeated ones are linked at runtime, in order with the loops */
+    TreeNode* firstChild = LinksAtRuntime(node) ? NULL : NextEager(node->child);
+    TreeNode* nextSibling = hasViewParent ? NextEager(node->sibling) : NULL;
+
+    if (!isWindow && (hasViewParent || firstChild))
+    {
+        BufferPrintf(target, "\t{ offsetof(%s_t, %s.view), ", moduleNameBuffer, node->instanceName);
+
+        if (hasViewParent)
+        {
+            BufferPrintf(target, "offsetof(%s_t, %s.view), ", moduleNameBuffer, node->parent->instanceName);
+        }
+        else
+        {
+            BufferPrintf(target, "NKGEN_NO_VIEW, ");
+        }
+
+        if (firstChild)
+        {
+            BufferPrintf(target, "offsetof(%s_t, %s.view), ", moduleNameBuffer, firstChild->instanceName);
+        }
+        else
+        {
+            BufferPrintf(target, "NKGEN_NO_VIEW, ");
+        }
+
+        if (nextSibling)
+        {
+            BufferPrintf(target, "offsetof(%s_t, %s.view) },\n", moduleNameBuffer, nextSibling->instanceName);
+        }
+        else
+        {
+            BufferPrintf(target, "NKGEN_NO_VIEW },\n");
+        }
+
+        linkRowCount++;
+    }
+
+    /* deferred subtrees are left out, their Realize function links them, repeated ones are linked by their loop */
+    for (TreeNode* childNode = NextEager(node->child); childNode != NULL; childNode = NextEager(childNode->sibling))
+    {
+        if (!childNode->repeatCount)
+        {
+            WriteLinkRows(childNode, target);
+        }
+    }
+}
+
+static void WriteLinkStores(TreeNode* node, OutputBuffer* target, bool viewFields)
+{
+    TreeNode* firstChild = NextEager(node->child);
+
+    if (strcmp(node->className, "Window") == 0)
+    {
+        if (firstChild && !LinksAtRuntime(node))
+        {
+            BufferPrintf(target,
+                "\tthis->%s.rootView = (nkView_t *)&this->%s.view;\n",
+                node->instanceName,
+                firstChild->instanceName
+            );
+        }
+    }
+    else if (viewFields && firstChild && !LinksAtRuntime(node))
+    {
+        BufferPrintf(target,
+            "\tthis->%s.view.NKGEN_VIEW_CHILD = &this->%s.view;\n",
+            node->instanceName,
+            firstChild->instanceName
+        );
+
+        for (TreeNode* childNode = firstChild; childNode != NULL; childNode = NextEager(childNode->sibling))
+        {
+            TreeNode* nextSibling = NextEager(childNode->sibling);
+
+            BufferPrintf(target,
+                "\tthis->%s.view.NKGEN_VIEW_PARENT = &this->%s.view;\n",
+                childNode->instanceName,
+                node->instanceName
+            );
+
+            if (nextSibling)
+            {
+                BufferPrintf(target,
+                    "\tthis->%s.view.NKGEN_VIEW_SIBLING = &this->%s.view;\n",
+                    childNode->instanceName,
+                    nextSibling->instanceName
+                );
+            }
+        }
+    }
+
+    for (TreeNode* childNode = firstChild; childNode != NULL; childNode = NextEager(childNode->sibling))
+    {
+        if (!childNode->repeatCount) /* linked by its loop */
+        {
+            WriteLinkStores(childNode, target, viewFields);
+        }
+    }
+}
+
+static void WriteRealizeFlags(TreeNode* node, OutputBuffer* target)
+{
+    /* siblings are walked in a loop, only depth recurses */
+    for (; node != NULL; node = node->sibling)
+    {
+        if (node->deferred)
+        {
+            BufferPrintf(target, "\tthis->%sRealized = false;\n", node->instanceName);
+        }
+
+        if (node->child)
+        {
+            WriteRealizeFlags(node->child, target);
+        }
+    }
+}
+
+static void WriteRealizeFunctions(TreeNode* node)
+{
+    /* siblings are walked in a loop, only depth recurses */
+    for (; node != NULL; node = node->sibling)
+    {
+        if (node->deferred)
+        {
+            BufferPrintf(&output,
+"\n\
+/* Realize %s */\n\
+bool %s_Realize_%s(%s_t* this)\n\
+{\n\
+\tif (this->%sRealized) return true;\n\
+",
+                node->instanceName,
+                moduleNameBuffer,
+                node->instanceName,
+                moduleNameBuffer,
+                node->instanceName
+            );
+
+            /* the nearest deferred ancestor owns the parent this subtree is added to */
+            for (TreeNode* ancestor = node->parent; ancestor != NULL; ancestor = ancestor->parent)
+            {
+                if (ancestor->deferred)
+                {
+                    BufferPrintf(&output,
+                        "\tif (!%s_Realize_%s(this)) return false;\n",
+                        moduleNameBuffer,
+                        ancestor->instanceName
+                    );
+                    break;
+                }
+            }
+
+            BufferPrintf(&output, "\n");
+
+            /* always unrolled, a realized subtree is usually small and built once */
+            InitialiseNode(node);
+
+            if (staticLinks)
+            {
+                BufferPrintf(&output, "\n");
+                WriteLinkStores(node, &output, true);
+            }
+
+            WriteBindingSync(node);
+            WriteThemeSites(node);
+
+            /* without static links NanoKit owns the hierarchy, so it is only changed through nkView_AddChildView
+               and a subtree realized before a later sibling's is laid out after it */
+            if (!staticLinks || node->sibling == NULL || strcmp(node->parent->className, "Window") == 0)
+            {
+                /* last in the markup, appending keeps the document order */
+                WriteAddChild(node->parent, node);
+            }
+            else
+            {
+                WriteInsertChild(node);
+            }
+
+            BufferPrintf(&output,
+"\n\
+\tthis->%sRealized = true;\n\
+\treturn true;\n\
+}\n\
+",
+                node->instanceName
+            );
+        }
+
+        if (node->child)
+        {
+            WriteRealizeFunctions(node->child);
+        }
+    }
+}
+
+static void WriteInsertChild(const TreeNode* node)
+{
+    const TreeNode* parent = node->parent;
+
+    /* after the nearest earlier sibling that exists, deferred ones only once realized,
+       appending would put the subtree after later siblings and change the order layout sees,
+       only with static links, the eager views were linked by the same direct stores */
+    const TreeNode* eager = node->prevSibling;
+
+    while (eager != NULL && eager->deferred) eager = eager->prevSibling;
+
+    if (eager)
+    {
+        BufferPrintf(&output, "\n\tnkView_t** link = &this->%sview.NKGEN_VIEW_SIBLING;\n", SiblingMember(eager));
+    }
+    else
+    {
+        BufferPrintf(&output, "\n\tnkView_t** link = &%sview.NKGEN_VIEW_CHILD;\n", ViewMember(parent));
+    }
+
+    for (const TreeNode* previous = node->prevSibling; previous != eager; previous = previous->prevSibling)
+    {
+        BufferPrintf(&output,
+            "\t%sif (this->%sRealized) link = &this->%sview.NKGEN_VIEW_SIBLING;\n",
+            (previous == node->prevSibling) ? "" : "else ",
+            previous->instanceName,
+            SiblingMember(previous)
+        );
+    }
+
+    const char* nodeMember = ViewMember(node);
+    const char* parentMember = ViewMember(parent);
+
+    BufferPrintf(&output,
+"\n\
+\t%sview.NKGEN_VIEW_PARENT = &%sview;\n\
+\t%sview.NKGEN_VIEW_SIBLING = *link;\n\
+\t*link = &%sview;\n\
+\n\
+\tNKGEN_INVALIDATE_VIEW(&%sview);\n\
+",
+        nodeMember,
+        parentMember,
+        nodeMember,
+        nodeMember,
+        parentMember
+    );
+}
+
+static const char* SiblingMember(const TreeNode* node)
+{
+    char* reference = references[nextReference++ % 4];
+
+    /* a repeated group was linked index by index, its last view is the last copy of its last element */
+    if (node->repeatCount)
+    {
+        snprintf(reference, sizeof(references[0]), "%s[%u].%s", node->instanceName, (unsigned)node->repeatCount - 1, node->component ? "super." : "");
+    }
+    else
+    {
+        snprintf(reference, sizeof(references[0]), "%s.%s", node->instanceName, node->component ? "super." : "");
+    }
+
+    return reference;
+}
+
+static bool InsertsDeferred(const TreeNode* node)
+{
+    /* siblings are walked in a loop, only depth recurses */
+    for (; node != NULL; node = node->sibling)
+    {
+        if (node->deferred && node->sibling != NULL && strcmp(node->parent->className, "Window") != 0) return true;
+
+        if (node->child && InsertsDeferred(node->child)) return true;
+    }
+
+    return false;
+}
+
+static TreeNode* NextEager(TreeNode* node)
+{
+    while (node != NULL && node->deferred)
+    {
+        node = node->sibling;
+    }
+
+    return node;
+}
+
+static void WriteBindingSupport(void)
+{
+    /* NKGEN_INVALIDATE_VIEW is called for every view a binding changed, memset clears the model */
+    supportNeeds |= SUPPORT_STRING | SUPPORT_INVALIDATE;
+}
+
+static void WriteBindingSync(const TreeNode* deferred)
+{
+    /* the first view built with a path seeds the model, later ones adopt what the model holds */
+    for (size_t i = 0; i < GetBindingSiteCount(); i++)
+    {
+        const BindingSite* site = GetBindingSite(i);
+
+        if (site->deferred != deferred) continue;
+
+        const BindingPath* path = GetBindingPath(site->path);
+        size_t word = site->path / 32;
+        unsigned bit = (unsigned)(site->path % 32);
+
+        OutputBuffer field;
+        BufferInit(&field, 256);
+        WriteBindingTarget(site, &field);
+
+        const BindingSite* seed = NULL;
+
+        for (size_t siteIndex = path->firstSite; siteIndex != BINDING_NONE && !seed; siteIndex = GetBindingSite(siteIndex)->nextSite)
+        {
+            if (!GetBindingSite(siteIndex)->deferred) seed = GetBindingSite(siteIndex);
+        }
+
+        if (deferred == NULL && seed == site)
+        {
+            BufferPrintf(&output,
+                "\tthis->model.%s = %s;\n\tthis->model.valid[%zu] |= 1u << %u;\n",
+                path->name,
+                field.data,
+                word,
+                bit
+            );
+        }
+        else if (deferred == NULL)
+        {
+            BufferPrintf(&output, "\t%s = this->model.%s;\n", field.data, path->name);
+        }
+        else
+        {
+            BufferPrintf(&output,
+"\n\
+\tif (this->model.valid[%zu] & (1u << %u)) %s = this->model.%s;\n\
+\telse { this->model.%s = %s; this->model.valid[%zu] |= 1u << %u; }\n\
+",
+                word,
+                bit,
+                field.data,
+                path->name,
+                path->name,
+                field.data,
+                word,
+                bit
+            );
+        }
+
+        BufferFree(&field);
+    }
+}
+
+static void WriteBindingSetters(void)
+{
+    for (size_t i = 0; i < GetBindingPathCount(); i++)
+    {
+        const BindingPath* path = GetBindingPath(i);
+        const char* typeName = GetTypeCodeName(path->type);
+
+        BufferPrintf(&output,
+"\n\
+void %s_Set%s(%s_t* this, %s value)\n\
+{\n\
+",
+            moduleNameBuffer,
+            path->name,
+            moduleNameBuffer,
+            typeName
+        );
+
+        switch (GetTypeComparison(path->type))
+        {
+            case COMPARE_STRING:
+                BufferPrintf(&output,
+                    "\tif (this->model.%s == value || (this->model.%s && value && strcmp(this->model.%s, value) == 0)) return;\n",
+                    path->name,
+                    path->name,
+                    path->name
+                );
+                break;
+            case COMPARE_MEMORY:
+                BufferPrintf(&output,
+                    "\tif (memcmp(&this->model.%s, &value, sizeof(value)) == 0) return;\n",
+                    path->name
+                );
+                break;
+            default:
+                BufferPrintf(&output, "\tif (this->model.%s == value) return;\n", path->name);
+                break;
+        }
+
+        BufferPrintf(&output,
+"\n\
+\tthis->model.%s = value;\n\
+\tthis->model.dirty[%zu] |= 1u << %u;\n\
+\tthis->model.valid[%zu] |= 1u << %u;\n\
+}\n\
+",
+            path->name,
+            i / 32,
+            (unsigned)(i % 32),
+            i / 32,
+            (unsigned)(i % 32)
+        );
+    }
+}
+
+static void WriteBindingApply(void)
+{
+    BufferPrintf(&output,
+"\n\
+/* Pushes changed values to the views bound to them */\n\
+bool %s_Apply(%s_t* this)\n\
+{\n\
+\tbool changed = false;\n\
+",
+        moduleNameBuffer,
+        moduleNameBuffer
+    );
+
+    for (size_t i = 0; i < GetBindingPathCount(); i++)
+    {
+        const BindingPath* path = GetBindingPath(i);
+
+        BufferPrintf(&output,
+"\n\
+\tif (this->model.dirty[%zu] & (1u << %u))\n\
+\t{\n\
+",
+            i / 32,
+            (unsigned)(i % 32)
+        );
+
+        for (size_t siteIndex = path->firstSite; siteIndex != BINDING_NONE; siteIndex = GetBindingSite(siteIndex)->nextSite)
+        {
+            const BindingSite* site = GetBindingSite(siteIndex);
+            const char* indent = site->deferred ? "\t\t\t" : "\t\t";
+            bool isWindow = strcmp(site->node->className, "Window") == 0;
+
+            if (site->deferred)
+            {
+                BufferPrintf(&output, "\t\tif (this->%sRealized)\n\t\t{\n", site->deferred->instanceName);
+            }
+
+            BufferPrintf(&output, "%s", indent);
+            WriteBindingTarget(site, &output);
+            BufferPrintf(&output, " = this->model.%s;\n", path->name);
+
+            if (!isWindow)
+            {
+                BufferPrintf(&output, "%sNKGEN_INVALIDATE_VIEW(&this->%s.view);\n", indent, site->node->instanceName);
+            }
+
+            if (site->deferred)
+            {
+                BufferPrintf(&output, "\t\t}\n");
+            }
+        }
+
+        BufferPrintf(&output, "\t\tchanged = true;\n\t}\n");
+    }
+
+    BufferPrintf(&output,
+"\n\
+\tmemset(this->model.dirty, 0, sizeof(this->model.dirty));\n\
+\treturn changed;\n\
+}\n\
+"
+    );
+}
+
+static void WriteBindingTarget(const BindingSite* site, OutputBuffer* target)
+{
+    BufferPrintf(target,
+        "this->%s%s.%s",
+        site->node->instanceName,
+        site->isInherited ? ".view" : "",
+        site->fieldName
+    );
+}
+
+static void WriteThemeSupport(void)
+{
+    /* one row of colours per theme, switching rewrites every themed field from the new row */
+    supportNeeds |= SUPPORT_STDDEF | SUPPORT_STDINT;
+
+    BufferPrintf(&output,
+"#ifndef NKGEN_THEME_CHANGED\n\
+#define NKGEN_THEME_CHANGED(module) ((void)(module))\n\
+#endif\n\
+\n"
+    );
+
+    if (GetThemeSiteCount() == 0) return;
+
+    WriteColorPacking(&output);
+
+    BufferPrintf(&output,
+"#ifndef NKGEN_THEME_FIXUPS\n\
+#define NKGEN_THEME_FIXUPS\n\
+\n\
+typedef struct\n\
+{\n\
+\tuint32_t offset;\n\
+\tuint32_t resource;\n\
+} nkgenThemeFixup_t;\n\
+\n\
+static void nkgen_ApplyTheme(uint8_t* base, const nkColor_t* resources, const nkgenThemeFixup_t* fixups, size_t fixupCount)\n\
+{\n\
+\tfor (size_t i = 0; i < fixupCount; i++)\n\
+\t{\n\
+\t\t*(nkColor_t*)(base + fixups[i].offset) = resources[fixups[i].resource];\n\
+\t}\n\
+}\n\
+\n\
+#endif /* NKGEN_THEME_FIXUPS */\n\
+\n\
+/* Theme resources, a row per %s_Theme_t */\n\
+static const nkColor_t %s_themeResources[%s_ThemeCount][%zu] = {\n",
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer,
+        GetThemeResourceCount()
+    );
+
+    for (size_t theme = 0; theme < GetThemeCount(); theme++)
+    {
+        BufferPrintf(&output, "\t{ ");
+
+        for (size_t resource = 0; resource < GetThemeResourceCount(); resource++)
+        {
+            if (resource > 0) BufferPrintf(&output, ", ");
+            WritePackedColor(GetThemeResourceValue(theme, resource), &output);
+        }
+
+        BufferPrintf(&output, " }, /* %s */\n", GetTheme(theme)->instanceName);
+    }
+
+    BufferPrintf(&output, "};\n\nstatic const nkgenThemeFixup_t %s_themeFixups[] = {\n", moduleNameBuffer);
+
+    for (size_t i = 0; i < GetThemeSiteCount(); i++)
+    {
+        const ThemeSite* site = GetThemeSite(i);
+
+        BufferPrintf(&output,
+            "\t{ offsetof(%s_t, %s%s.%s), %zu }, /* %s */\n",
+            moduleNameBuffer,
+            site->node->instanceName,
+            site->isInherited ? ".view" : "",
+            site->fieldName,
+            site->resource,
+            GetThemeResourceName(site->resource)
+        );
+    }
+
+    BufferPrintf(&output, "};\n\n");
+}
+
+static void WriteThemeSites(const TreeNode* deferred)
+{
+    bool first = true;
+
+    for (size_t i = 0; i < GetThemeSiteCount(); i++)
+    {
+        const ThemeSite* site = GetThemeSite(i);
+
+        if (site->deferred != deferred) continue;
+
+        if (first)
+        {
+            BufferPrintf(&output, "\n\t/* Themed fields, from the current theme */\n");
+            first = false;
+        }
+
+        BufferPrintf(&output,
+            "\tthis->%s%s.%s = %s_themeResources[this->theme][%zu];\n",
+            site->node->instanceName,
+            site->isInherited ? ".view" : "",
+            site->fieldName,
+            moduleNameBuffer,
+            site->resource
+        );
+    }
+}
+
+static void WriteSetTheme(void)
+{
+    BufferPrintf(&output,
+"\n\
+/* Set Theme */\n\
+void %s_SetTheme(%s_t* this, %s_Theme_t theme)\n\
+{\n\
+\tif ((unsigned)theme >= (unsigned)%s_ThemeCount || theme == this->theme) return;\n\
+\n\
+\tthis->theme = theme;\n\
+",
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer
+    );
+
+    if (GetThemeSiteCount() > 0)
+    {
+        BufferPrintf(&output,
+            "\tnkgen_ApplyTheme((uint8_t*)this, %s_themeResources[theme], %s_themeFixups, %zu);\n",
+            moduleNameBuffer,
+            moduleNameBuffer,
+            GetThemeSiteCount()
+        );
+    }
+
+    BufferPrintf(&output, "\n\tNKGEN_THEME_CHANGED(this);\n}\n");
+}
+
+static void WriteListSupport(void)
+{
+    /* rows are linked under their list through the hierarchy fields, only visible items are in the chain */
+    supportNeeds |= SUPPORT_STDINT | SUPPORT_INVALIDATE;
+
+    BufferPrintf(&output,
+"#ifndef NKGEN_NO_ITEM\n\
+#define NKGEN_NO_ITEM SIZE_MAX\n\
+#endif\n\
+\n"
+    );
+
+    if (!staticLinks)
+    {
+        WriteLinkSupport(false);
+    }
+}
+
+static void WriteListRows(const TreeNode* list)
+{
+    const TreeNode* row = list->items->root;
+
+    /* every row is the template unrolled once, the loop keeps the code size independent of the pool */
+    OutputBuffer moduleOutput = output;
+    bool moduleStaticLinks = staticLinks;
+    bool moduleShareShapes = shareShapes;
+
+    /* helpers follow the module's links, rows always link at runtime */
+    BufferInit(&output, 4 * 1024);
+    instanceBase = "row->";
+    shareShapes = shareShapes && !staticLinks;
+    staticLinks = false;
+
+    InitialiseNode((TreeNode*)row);
+
+    OutputBuffer rowOutput = output;
+    output = moduleOutput;
+    instanceBase = "this->";
+    staticLinks = moduleStaticLinks;
+    shareShapes = moduleShareShapes;
+
+    BufferPrintf(&output,
+"\n\
+\t/* Rows of %s, bound to items by %s_ScrollTo_%s */\n\
+\tfor (size_t i = 0; i < %u; i++)\n\
+\t{\n\
+\t\t%s_%sRow_t* row = &this->%sRows[i];\n\
+\n\
+",
+        list->instanceName,
+        moduleNameBuffer,
+        list->instanceName,
+        (unsigned)list->items->poolSize,
+        moduleNameBuffer,
+        list->instanceName,
+        list->instanceName
+    );
+
+    WriteIndented(&rowOutput, &output);
+    BufferFree(&rowOutput);
+
+    BufferPrintf(&output,
+"\n\
+\t\trow->%s.view.NKGEN_VIEW_PARENT = &this->%s.view;\n\
+\t\tthis->%sRowItems[i] = NKGEN_NO_ITEM;\n\
+\t}\n\
+\n\
+\tthis->%sItemCount = 0;\n\
+\tthis->%sFirstItem = 0;\n\
+",
+        row->instanceName,
+        list->instanceName,
+        list->instanceName,
+        list->instanceName,
+        list->instanceName
+    );
+}
+
+static void WriteListFunctions(const TreeNode* list)
+{
+    const char* name = list->instanceName;
+    unsigned poolSize = (unsigned)list->items->poolSize;
+
+    /* item k always lands in row k % pool, so a row keeps its item while it stays in the window */
+    BufferPrintf(&output,
+"\n\
+/* Scroll %s */\n\
+void %s_ScrollTo_%s(%s_t* this, size_t firstItem)\n\
+{\n\
+\tsize_t itemCount = this->%sItemCount;\n\
+\n\
+\t/* the window stays full at the end of the list */\n\
+\tif (itemCount <= %u) firstItem = 0;\n\
+\telse if (firstItem > itemCount - %u) firstItem = itemCount - %u;\n\
+\n\
+\tsize_t visibleCount = (itemCount - firstItem < %u) ? itemCount - firstItem : %u;\n\
+\tnkView_t** link = &this->%s.view.NKGEN_VIEW_CHILD;\n\
+\n\
+\tfor (size_t i = 0; i < visibleCount; i++)\n\
+\t{\n\
+\t\tsize_t item = firstItem + i;\n\
+\t\tsize_t slot = item %% %u;\n\
+\t\t%s_%sRow_t* row = &this->%sRows[slot];\n\
+\n\
+\t\t/* only recycled rows are bound again */\n\
+\t\tif (this->%sRowItems[slot] != item)\n\
+\t\t{\n\
+\t\t\tthis->%sRowItems[slot] = item;\n\
+\t\t\t%s(this, row, item);\n\
+\t\t}\n\
+\n\
+\t\t*link = (nkView_t *)&row->%s.view;\n\
+\t\tlink = &row->%s.view.NKGEN_VIEW_SIBLING;\n\
+\t}\n\
+\n\
+\t*link = NULL;\n\
+\tthis->%sFirstItem = firstItem;\n\
+\n\
+\tNKGEN_INVALIDATE_VIEW(&this->%s.view);\n\
+}\n\
+",
+        name,
+        moduleNameBuffer, name, moduleNameBuffer,
+        name,
+        poolSize,
+        poolSize, poolSize,
+        poolSize, poolSize,
+        name,
+        poolSize,
+        moduleNameBuffer, name, name,
+        name,
+        name,
+        list->items->itemBound,
+        list->items->root->instanceName,
+        list->items->root->instanceName,
+        name,
+        name
+    );
+
+    BufferPrintf(&output,
+"\n\
+/* Set Item Count of %s */\n\
+void %s_SetItemCount_%s(%s_t* this, size_t itemCount)\n\
+{\n\
+\t/* rows past the new end would otherwise keep a stale item if the list grows back */\n\
+\tfor (size_t slot = 0; slot < %u; slot++)\n\
+\t{\n\
+\t\tif (this->%sRowItems[slot] >= itemCount) this->%sRowItems[slot] = NKGEN_NO_ITEM;\n\
+\t}\n\
+\n\
+\tthis->%sItemCount = itemCount;\n\
+\t%s_ScrollTo_%s(this, this->%sFirstItem);\n\
+}\n\
+\n\
+/* Refresh Items of %s */\n\
+void %s_RefreshItems_%s(%s_t* this)\n\
+{\n\
+\tfor (size_t slot = 0; slot < %u; slot++)\n\
+\t{\n\
+\t\tthis->%sRowItems[slot] = NKGEN_NO_ITEM;\n\
+\t}\n\
+\n\
+\t%s_ScrollTo_%s(this, this->%sFirstItem);\n\
+}\n\
+",
+        name,
+        moduleNameBuffer, name, moduleNameBuffer,
+        poolSize,
+        name, name,
+        name,
+        moduleNameBuffer, name, name,
+        name,
+        moduleNameBuffer, name, moduleNameBuffer,
+        poolSize,
+        name,
+        moduleNameBuffer, name, name
+    );
+}
+
+static void WriteLayoutSupport(bool withTable)
+{
+    /* frames are parent relative nkRect_t values, NKGEN_LAYOUT_PRECOMPUTED lets NanoKit skip measuring a subtree */
+    BufferPrintf(&output,
+"#ifndef NKGEN_VIEW_FRAME\n\
+#define NKGEN_VIEW_FRAME frame\n\
+#endif\n\
+\n\
+#ifndef NKGEN_LAYOUT_PRECOMPUTED\n\
+#define NKGEN_LAYOUT_PRECOMPUTED(view) ((void)(view))\n\
+#endif\n\
+\n"
+    );
+
+    if (!withTable) return;
+
+    supportNeeds |= SUPPORT_STDDEF | SUPPORT_STDINT;
+
+    BufferPrintf(&output,
+"#ifndef NKGEN_LAYOUT_FRAMES\n\
+#define NKGEN_LAYOUT_FRAMES\n\
+\n\
+typedef struct\n\
+{\n\
+\tuint32_t offset;\n\
+\tnkRect_t frame;\n\
+} nkgenFrame_t;\n\
+\n\
+static void nkgen_ApplyFrames(uint8_t* base, const nkgenFrame_t* frames, size_t frameCount)\n\
+{\n\
+\tfor (size_t i = 0; i < frameCount; i++)\n\
+\t{\n\
+\t\t*(nkRect_t*)(base + frames[i].offset) = frames[i].frame;\n\
+\t}\n\
+}\n\
+\n\
+#endif /* NKGEN_LAYOUT_FRAMES */\n\
+\n\
+static const nkgenFrame_t %s_frames[] = {\n",
+        moduleNameBuffer
+    );
+
+    for (size_t i = 0; i < GetLayoutFrameCount(); i++)
+    {
+        const LayoutFrame* frame = GetLayoutFrame(i);
+
+        if (frame->sizeOnly) continue;
+
+        BufferPrintf(&output,
+            "\t{ offsetof(%s_t, %s.view.NKGEN_VIEW_FRAME), ",
+            moduleNameBuffer,
+            frame->node->instanceName
+        );
+
+        WriteRect(frame, false, &output);
+
+        BufferPrintf(&output, " },\n");
+    }
+
+    BufferPrintf(&output, "};\n\n");
+}
+
+static void WriteLayoutFrames(SourceBackend backend)
+{
+    BufferPrintf(&output, "\n\t/* Layout precomputed by nkgen */\n");
+
+    size_t tableFrameCount = 0;
+
+    for (size_t i = 0; i < GetLayoutFrameCount(); i++)
+    {
+        const LayoutFrame* frame = GetLayoutFrame(i);
+        const char* name = frame->node->instanceName;
+
+        if (backend == SOURCE_BACKEND_PROTOTYPE)
+        {
+            /* copied with the rest of the prototype */
+        }
+        else if (frame->sizeOnly)
+        {
+            BufferPrintf(&output, "\tthis->%s.view.NKGEN_VIEW_FRAME.width = ", name);
+            WriteFloat(frame->width, &output);
+            BufferPrintf(&output, ";\n\tthis->%s.view.NKGEN_VIEW_FRAME.height = ", name);
+            WriteFloat(frame->height, &output);
+            BufferPrintf(&output, ";\n");
+        }
+        else if (backend == SOURCE_BACKEND_TABLE)
+        {
+            tableFrameCount++;
+        }
+        else
+        {
+            BufferPrintf(&output, "\tthis->%s.view.NKGEN_VIEW_FRAME = ", name);
+            WriteRect(frame, true, &output);
+            BufferPrintf(&output, ";\n");
+        }
+    }
+
+    if (tableFrameCount > 0)
+    {
+        BufferPrintf(&output,
+            "\tnkgen_ApplyFrames((uint8_t*)this, %s_frames, %zu);\n",
+            moduleNameBuffer,
+            tableFrameCount
+        );
+    }
+
+    for (size_t i = 0; i < GetLayoutFrameCount(); i++)
+    {
+        const LayoutFrame* frame = GetLayoutFrame(i);
+
+        if (!frame->sizeOnly) continue;
+
+        BufferPrintf(&output,
+            "\tthis->%sLayoutValid = true;\n\tNKGEN_LAYOUT_PRECOMPUTED(&this->%s.view);\n",
+            frame->node->instanceName,
+            frame->node->instanceName
+        );
+    }
+}
+
+static void WriteRect(const LayoutFrame* frame, bool isLiteral, OutputBuffer* target)
+{
+    /* static initializers take the bare braces, assignments a compound literal */
+    BufferPrintf(target, "%s{ .x = ", isLiteral ? "(nkRect_t)" : "");
+    WriteFloat(frame->x, target);
+    BufferPrintf(target, ", .y = ");
+    WriteFloat(frame->y, target);
+    BufferPrintf(target, ", .width = ");
+    WriteFloat(frame->width, target);
+    BufferPrintf(target, ", .height = ");
+    WriteFloat(frame->height, target);
+    BufferPrintf(target, " }");
+}
+
+static void WriteFloat(float value, OutputBuffer* target)
+{
+    /* shortest form that still reads as a float literal */
+    char text[32];
+    snprintf(text, sizeof(text), "%.9g", value);
+
+    BufferPrintf(target, "%s%sf", text, strpbrk(text, ".e") ? "" : ".0");
+}
+
+static void WriteViewIds(void)
+{
+    size_t count = GetViewIdCount();
+    size_t bucketCount = GetViewBucketCount();
+    uint32_t largestDisplacement = 0;
+
+    for (size_t i = 0; i < bucketCount; i++)
+    {
+        if (GetViewDisplacement(i) > largestDisplacement) largestDisplacement = GetViewDisplacement(i);
+    }
+
+    /* the narrowest types that hold the IDs and displacements, both tables are read once per lookup */
+    const char* idType = (count <= UINT8_MAX) ? "uint8_t" : (count <= UINT16_MAX) ? "uint16_t" : "uint32_t";
+    const char* displacementType = (largestDisplacement <= UINT8_MAX) ? "uint8_t" : (largestDisplacement <= UINT16_MAX) ? "uint16_t" : "uint32_t";
+
+    supportNeeds |= SUPPORT_STDDEF | SUPPORT_STDINT | SUPPORT_STRING;
+
+    BufferPrintf(&output, "\n/* View IDs - Member Offsets and a Minimal Perfect Hash of the Names, Built by nkgen */\nstatic const size_t %s_viewOffsets[%s_ViewCount] = {\n", moduleNameBuffer, moduleNameBuffer);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        BufferPrintf(&output, "\toffsetof(%s_t, %s),\n", moduleNameBuffer, GetViewIdNode(i)->instanceName);
+    }
+
+    BufferPrintf(&output, "};\n\n/* Names in hash slot order, each with the ID of its view */\nstatic const char* const %s_viewNames[%zu] = {\n", moduleNameBuffer, count);
+
+    for (size_t slot = 0; slot < count; slot++)
+    {
+        BufferPrintf(&output, "\t\"%s\",\n", GetViewIdNode(GetViewSlotId(slot))->instanceName);
+    }
+
+    BufferPrintf(&output, "};\n\nstatic const %s %s_viewSlotIds[%zu] = {", idType, moduleNameBuffer, count);
+
+    for (size_t slot = 0; slot < count; slot++)
+    {
+        BufferPrintf(&output, "%s%zu", (slot % 16 == 0) ? "\n\t" : " ", GetViewSlotId(slot));
+        if (slot + 1 < count) BufferPrintf(&output, ",");
+    }
+
+    BufferPrintf(&output, "\n};\n\nstatic const %s %s_viewDisplacements[%zu] = {", displacementType, moduleNameBuffer, bucketCount);
+
+    for (size_t i = 0; i < bucketCount; i++)
+    {
+        BufferPrintf(&output, "%s%u", (i % 16 == 0) ? "\n\t" : " ", (unsigned)GetViewDisplacement(i));
+        if (i + 1 < bucketCount) BufferPrintf(&output, ",");
+    }
+
+    /* the hash and slot mixing match lookup.c, the seed was picked there */
+    BufferPrintf(&output,
+"\n\
+};\n\
+\n\
+%s_ViewId_t %s_FindByName(const char* name)\n\
+{\n\
+\tuint32_t hash = 0x%08Xu;\n\
+\n\
+\tfor (const char* c = name; *c != '\\0'; c++)\n\
+\t{\n\
+\t\thash ^= (uint8_t)*c;\n\
+\t\thash *= 16777619u;\n\
+\t}\n\
+\n\
+\tuint32_t mixed = hash + %s_viewDisplacements[hash %% %zuu] * 0x9E3779B9u;\n\
+\tmixed ^= mixed >> 16;\n\
+\tmixed *= 0x85EBCA6Bu;\n\
+\tmixed ^= mixed >> 13;\n\
+\n\
+\tuint32_t slot = mixed %% %zuu;\n\
+\n\
+\treturn (strcmp(%s_viewNames[slot], name) == 0) ? (%s_ViewId_t)%s_viewSlotIds[slot] : %s_ViewCount;\n\
+}\n\
+\n\
+void* %s_GetView(%s_t* this, %s_ViewId_t id)\n\
+{\n\
+\treturn ((size_t)id < %s_ViewCount) ? (uint8_t*)this + %s_viewOffsets[id] : NULL;\n\
+}\n\
+",
+        moduleNameBuffer,
+        moduleNameBuffer,
+        (unsigned)GetViewHashSeed(),
+        moduleNameBuffer,
+        bucketCount,
+        count,
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer
+    );
+}
+
+static void WriteDispatch(void)
+{
+    size_t viewCount = GetViewIdCount();
+    size_t eventCount = GetEventCount();
+    size_t handlerCount = GetHandlerCount();
+
+    /* one row per view, the entry is the case of the handler or 0 */
+    const char* routeType = (handlerCount < UINT8_MAX) ? "uint8_t" : (handlerCount < UINT16_MAX) ? "uint16_t" : "uint32_t";
+
+    supportNeeds |= SUPPORT_STDBOOL | SUPPORT_STDDEF | SUPPORT_STDINT;
+
+    BufferPrintf(&output, "\n/* Events - Handler of Every View and Event, Built by nkgen */\nstatic const %s %s_routes[%s_ViewCount][%s_EventCount] = {\n", routeType, moduleNameBuffer, moduleNameBuffer, moduleNameBuffer);
+
+    for (size_t id = 0; id < viewCount; id++)
+    {
+        BufferPrintf(&output, "\t{");
+
+        for (size_t event = 0; event < eventCount; event++)
+        {
+            BufferPrintf(&output, "%s%zu", event ? ", " : " ", GetRoute(id, event));
+        }
+
+        BufferPrintf(&output, " },\n");
+    }
+
+    BufferPrintf(&output,
+"};\n\
+\n\
+bool %s_Dispatch(%s_t* this, %s_ViewId_t id, %s_Event_t event, void* sender)\n\
+{\n\
+\tif ((size_t)id >= %s_ViewCount || (size_t)event >= %s_EventCount) return false;\n\
+\n\
+\tif (!sender) sender = (uint8_t*)this + %s_viewOffsets[id];\n\
+\n\
+\tswitch (%s_routes[id][event])\n\
+\t{\n\
+",
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer
+    );
+
+    /* direct calls, the compiler sees every handler and may inline it */
+    for (size_t i = 0; i < handlerCount; i++)
+    {
+        const RouteHandler* handler = GetHandler(i);
+
+        BufferPrintf(&output, "\t\tcase %zu: ", i + 1);
+        WriteCallbackCall(handler->type, handler->name, "sender", &output);
+        BufferPrintf(&output, "; return true;\n");
+    }
+
+    BufferPrintf(&output, "\t\tdefault: return false;\n\t}\n}\n");
+}
+
+static void WriteFootprint(void)
+{
+    /* the sizes of NanoKit's structs are only known to the compiler, only the cap on the total needs a number from the build */
+    supportNeeds |= SUPPORT_STDDEF;
+
+    BufferPrintf(&output,
+"\n\
+/* Footprint - Member Sizes From the Compiler, Define %s_XML_FOOTPRINT_LIMIT to Cap sizeof(%s_t) */\n\
+#ifdef %s_XML_FOOTPRINT_LIMIT\n\
+_Static_assert(sizeof(%s_t) <= %s_XML_FOOTPRINT_LIMIT, \"%s_t is larger than %s_XML_FOOTPRINT_LIMIT, see its footprint manifest\");\n\
+#endif\n\
+\n\
+",
+        moduleNameUpper,
+        moduleNameBuffer,
+        moduleNameUpper,
+        moduleNameBuffer,
+        moduleNameUpper,
+        moduleNameBuffer,
+        moduleNameUpper
+    );
+
+    /* always checked, a member whose size no longer matches its manifest line fails the build,
+       and so does a view declared out of the manifest's order */
+    char type[256];
+    char rowName[256];
+    char rowType[512];
+    const char* previous = NULL;
+
+    BufferPrintf(&output, "/* Member sizes and order as listed in the footprint manifest */\n");
+
+    for (size_t i = 0; i < GetMemberCount(); i++)
+    {
+        const TreeNode* node = GetMember(i)->node;
+
+        WriteFootprintGuard(node->instanceName, MemberType(node, type, sizeof(type)), node->repeatCount ? node->repeatCount : 1, previous);
+        previous = node->instanceName;
+    }
+
+    for (size_t i = 0; i < GetListCount(); i++)
+    {
+        const TreeNode* list = GetList(i);
+
+        snprintf(rowName, sizeof(rowName), "%sRows", list->instanceName);
+        snprintf(rowType, sizeof(rowType), "%s_%sRow_t", moduleNameBuffer, list->instanceName);
+
+        WriteFootprintGuard(rowName, rowType, list->items->poolSize, NULL);
+    }
+
+    if (GetBindingPathCount() > 0)
+    {
+        snprintf(rowType, sizeof(rowType), "%s_ViewModel_t", moduleNameBuffer);
+        WriteFootprintGuard("model", rowType, 1, NULL);
+    }
+
+    BufferPrintf(&output, "\nstatic const nkgenFootprint_t %s_footprint[] = {\n", moduleNameBuffer);
+
+    for (size_t i = 0; i < GetMemberCount(); i++)
+    {
+        const char* name = GetMember(i)->node->instanceName;
+
+        BufferPrintf(&output, "\t{ \"%s\", offsetof(%s_t, %s), sizeof(((%s_t*)0)->%s) },\n", name, moduleNameBuffer, name, moduleNameBuffer, name);
+    }
+
+    /* the same state the manifest lists after the views */
+    for (size_t i = 0; i < GetListCount(); i++)
+    {
+        const char* name = GetList(i)->instanceName;
+
+        BufferPrintf(&output, "\t{ \"%sRows\", offsetof(%s_t, %sRows), sizeof(((%s_t*)0)->%sRows) },\n", name, moduleNameBuffer, name, moduleNameBuffer, name);
+    }
+
+    if (GetBindingPathCount() > 0)
+    {
+        BufferPrintf(&output, "\t{ \"model\", offsetof(%s_t, model), sizeof(((%s_t*)0)->model) },\n", moduleNameBuffer, moduleNameBuffer);
+    }
+
+    BufferPrintf(&output,
+"};\n\
+\n\
+size_t %s_GetFootprint(const nkgenFootprint_t** members, size_t* total)\n\
+{\n\
+\t*members = %s_footprint;\n\
+\tif (total) *total = sizeof(%s_t);\n\
+\treturn sizeof(%s_footprint) / sizeof(%s_footprint[0]);\n\
+}\n\
+",
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer,
+        moduleNameBuffer
+    );
+}
+
+static void WriteFootprintGuard(const char* name, const char* type, size_t count, const char* previous)
+{
+    if (count > 1)
+    {
+        BufferPrintf(&output,
+            "_Static_assert(sizeof(((%s_t*)0)->%s) == %zu * sizeof(%s), \"%s_t.%s does not match its footprint manifest\");\n",
+            moduleNameBuffer, name, count, type, moduleNameBuffer, name
+        );
+    }
+    else
+    {
+        BufferPrintf(&output,
+            "_Static_assert(sizeof(((%s_t*)0)->%s) == sizeof(%s), \"%s_t.%s does not match its footprint manifest\");\n",
+            moduleNameBuffer, name, type, moduleNameBuffer, name
+        );
+    }
+
+    if (previous)
+    {
+        BufferPrintf(&output,
+            "_Static_assert(offsetof(%s_t, %s) > offsetof(%s_t, %s), \"%s_t.%s is declared out of its footprint manifest order\");\n",
+            moduleNameBuffer, name, moduleNameBuffer, previous, moduleNameBuffer, name
+        );
+    }
+}
@@ -30,10 +30,35 @@
 ** MARK: TYPEDEFS
 ***************************************************************/
 
+typedef enum
+{
+    SOURCE_BACKEND_UNROLLED,    /* one statement per constructor, property and link */
+    SOURCE_BACKEND_TABLE,       /* const descriptor tables walked by a shared builder loop */
+    SOURCE_BACKEND_PROTOTYPE    /* constant fields copied from a const image of the module struct */
+} SourceBackend;
+
+typedef struct
+{
+    SourceBackend backend;
+    bool staticLinks;           /* parent, first child and next sibling resolved at generation time instead of nkView_AddChildView */
+    bool poolConstants;         /* strings and hex colours interned into one static const pool per module */
+    bool shareSubtrees;         /* identical subtrees written once as init helpers and called per occurrence */
+    size_t chunkCount;          /* sources _Create is spread over including the module source, 0 or 1 keeps it whole */
+    const char* const* chunkPaths;  /* chunkCount - 1 paths written into the chunk banners */
+    const char* moduleStruct;   /* struct definition left out of an opaque header, NULL when the header defines it */
+    bool footprint;             /* member sizes asserted against the manifest, member and struct sizes behind _GetFootprint, capped by <MODULE>_XML_FOOTPRINT_LIMIT if defined */
+} SourceOptions;
+
 /***************************************************************
 ** MARK: FUNCTION DEFS
 ***************************************************************/
 
-void WriteSourceFile(const char* path, const char* moduleName, TreeNode* fileContents);
+/* Returns the generated file contents, the caller must free them,
+   chunks and chunkSizes take the other chunkCount - 1 sources and are only used when splitting */
+char* GenerateSourceFile(const char* path, const char* moduleName, TreeNode* fileContents, const SourceOptions* options, size_t* size, char** chunks, size_t* chunkSizes);
+
+/* Init helpers the last GenerateSourceFile shared subtrees through,
+   and the source bytes they saved over writing every occurrence inline, chunks included */
+void GetSharedSubtreeStats(size_t* helperCount, size_t* bytesSaved);
 
 #endif /* SOURCE_H */
\ No newline at end of file
@@ -0,0 +1,319 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  split.c
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen partitioning of the unrolled constructors into chunk sources
+**
+***************************************************************/
+
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stats/alloc.h>
+
+#include <binding/binding.h>
+#include <theme/theme.h>
+#include <shape/shape.h>
+#include <route/route.h>
+
+#include "split.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define SPLIT_MIN_WEIGHT 8      /* smaller subtrees are not worth a call and a prototype */
+#define SPLIT_MAX_WEIGHT 4096   /* bounds the statements in one function whatever the chunk count */
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static Cut* cuts = NULL;
+static size_t cutCount = 0;
+static size_t cutCapacity = 0;
+
+/* the same cuts ordered by node, for FindCut */
+static const Cut** sortedCuts = NULL;
+
+static size_t weightLimit = 0;
+
+/* statements of every function written unrolled, _Create and the Realize functions */
+static size_t writtenWeight = 0;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static size_t Weigh(const TreeNode* node);
+static size_t Partition(const TreeNode* node, const TreeNode* owner);
+static bool AddCut(const TreeNode* node, const TreeNode* owner, size_t weight);
+
+static int CompareWeights(const void* a, const void* b);
+static int CompareNodes(const void* a, const void* b);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+void CollectCuts(const TreeNode* rootNode, size_t chunkCount, bool mainTree)
+{
+    ClearCuts();
+
+    if (!rootNode || chunkCount < 2) return;
+
+    if (chunkCount > SPLIT_MAX_CHUNKS)
+    {
+        chunkCount = SPLIT_MAX_CHUNKS;
+    }
+
+    /* weighed once without cutting, then every chunk gets about the same share and no function more than the cap */
+    for (size_t pass = 0; pass < 2; pass++)
+    {
+        writtenWeight = 0;
+
+        size_t rootWeight = Partition(rootNode, mainTree ? rootNode : NULL);
+
+        if (mainTree)
+        {
+            writtenWeight += rootWeight;
+        }
+
+        if (pass == 0)
+        {
+            weightLimit = (writtenWeight + chunkCount - 1) / chunkCount;
+
+            if (weightLimit > SPLIT_MAX_WEIGHT)
+            {
+                weightLimit = SPLIT_MAX_WEIGHT;
+            }
+        }
+    }
+
+    size_t total = writtenWeight;
+
+    if (cutCount == 0) return;
+
+    const Cut** byWeight = (const Cut**)malloc(cutCount * sizeof(const Cut*));
+    sortedCuts = (const Cut**)malloc(cutCount * sizeof(const Cut*));
+
+    if (!byWeight || !sortedCuts)
+    {
+        free(byWeight);
+        ClearCuts();
+        return;
+    }
+
+    /* what is not cut is part of the module source's load, each cut leaves a call behind */
+    size_t loads[SPLIT_MAX_CHUNKS] = { 0 };
+    loads[0] = total;
+
+    for (size_t i = 0; i < cutCount; i++)
+    {
+        loads[0] -= cuts[i].weight - 1;
+        byWeight[i] = &cuts[i];
+        sortedCuts[i] = &cuts[i];
+    }
+
+    /* largest first into the lightest chunk, ties go to the lower index so the result is stable */
+    qsort(byWeight, cutCount, sizeof(const Cut*), CompareWeights);
+
+    for (size_t i = 0; i < cutCount; i++)
+    {
+        size_t lightest = 0;
+
+        for (size_t chunk = 1; chunk < chunkCount; chunk++)
+        {
+            if (loads[chunk] < loads[lightest]) lightest = chunk;
+        }
+
+        ((Cut*)byWeight[i])->chunk = lightest;
+        loads[lightest] += byWeight[i]->weight;
+    }
+
+    free(byWeight);
+
+    qsort(sortedCuts, cutCount, sizeof(const Cut*), CompareNodes);
+}
+
+void ClearCuts(void)
+{
+    free(cuts);
+    free(sortedCuts);
+
+    cuts = NULL;
+    cutCount = 0;
+    cutCapacity = 0;
+    sortedCuts = NULL;
+    weightLimit = 0;
+    writtenWeight = 0;
+}
+
+size_t GetCutCount(void)
+{
+    return cutCount;
+}
+
+const Cut* GetCut(size_t index)
+{
+    return (index < cutCount) ? &cuts[index] : NULL;
+}
+
+const Cut* FindCut(const TreeNode* node)
+{
+    if (cutCount == 0) return NULL;
+
+    size_t low = 0;
+    size_t high = cutCount;
+
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+
+        if (sortedCuts[middle]->node == node) return sortedCuts[middle];
+
+        if ((uintptr_t)sortedCuts[middle]->node < (uintptr_t)node)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return NULL;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static size_t Weigh(const TreeNode* node)
+{
+    /* mirrors InitialiseNode: one constructor, one statement per written property, a shared subtree is one call */
+    if (FindShape(node)) return 1;
+
+    size_t weight = 1;
+
+    for (const NodeProperty* property = node->properties; property != NULL; property = property->next)
+    {
+        if (!IsBinding(property->value) && !IsThemeResource(property->value) && !IsRouted(property)) weight++;
+    }
+
+    for (const TreeNode* child = node->child; child != NULL; child = child->sibling)
+    {
+        if (!child->deferred)
+        {
+            weight += Weigh(child);
+        }
+    }
+
+    return weight;
+}
+
+static size_t Partition(const TreeNode* node, const TreeNode* owner)
+{
+    /* owner is the root of the function the node is written in, NULL where the tables build it */
+    if (node != owner && FindShape(node)) return 1;
+
+    size_t first = cutCount;
+    size_t weight = 1;
+
+    for (const NodeProperty* property = node->properties; property != NULL; property = property->next)
+    {
+        if (!IsBinding(property->value) && !IsThemeResource(property->value) && !IsRouted(property)) weight++;
+    }
+
+    for (const TreeNode* child = node->child; child != NULL; child = child->sibling)
+    {
+        /* a deferred view is the root of its own Realize, which is always unrolled */
+        if (child->deferred)
+        {
+            writtenWeight += Partition(child, child);
+            continue;
+        }
+
+        /* repeated views are written once inside a loop and reached through its index,
+           a UserControl is a single call to its own _Create */
+        if (child->repeatCount || child->component)
+        {
+            weight += Weigh(child);
+            continue;
+        }
+
+        size_t childWeight = Partition(child, owner);
+        weight += childWeight;
+
+        if (owner && childWeight >= SPLIT_MIN_WEIGHT && childWeight <= weightLimit)
+        {
+            AddCut(child, owner, childWeight);
+        }
+    }
+
+    /* a subtree that fits is cut as a whole by its parent, not in pieces, the root of a function has no parent to cut it
+       and cuts in the Realize functions of deferred descendants stay */
+    if (weight <= weightLimit && node != owner)
+    {
+        size_t kept = first;
+
+        for (size_t i = first; i < cutCount; i++)
+        {
+            if (cuts[i].owner != owner) cuts[kept++] = cuts[i];
+        }
+
+        cutCount = kept;
+    }
+
+    return weight;
+}
+
+static bool AddCut(const TreeNode* node, const TreeNode* owner, size_t weight)
+{
+    if (cutCount == cutCapacity)
+    {
+        size_t capacity = cutCapacity ? cutCapacity * 2 : 32;
+        Cut* grown = (Cut*)realloc(cuts, capacity * sizeof(Cut));
+
+        if (!grown) return false;
+
+        cuts = grown;
+        cutCapacity = capacity;
+    }
+
+    cuts[cutCount++] = (Cut){ node, owner, weight, 0 };
+    return true;
+}
+
+static int CompareWeights(const void* a, const void* b)
+{
+    const Cut* cutA = *(const Cut* const*)a;
+    const Cut* cutB = *(const Cut* const*)b;
+
+    if (cutA->weight != cutB->weight) return (cutA->weight > cutB->weight) ? -1 : 1;
+
+    return (cutA < cutB) ? -1 : (cutA > cutB) ? 1 : 0;
+}
+
+static int CompareNodes(const void* a, const void* b)
+{
+    uintptr_t nodeA = (uintptr_t)(*(const Cut* const*)a)->node;
+    uintptr_t nodeB = (uintptr_t)(*(const Cut* const*)b)->node;
+
+    return (nodeA < nodeB) ? -1 : (nodeA > nodeB) ? 1 : 0;
+}
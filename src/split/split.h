@@ -0,0 +1,62 @@
+/***************************************************************
+**
+** NanoKit Tool Header File
+**
+** File         :  split.h
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen partitioning of the unrolled constructors into chunk sources
+**
+***************************************************************/
+
+#ifndef SPLIT_H
+#define SPLIT_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <parser/parser.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define SPLIT_MAX_CHUNKS 64
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* A subtree built by its own function instead of inline in _Create or a Realize function */
+typedef struct
+{
+    const TreeNode* node;
+    const TreeNode* owner;  /* root of the function the call is written in, the module root or a deferred view */
+    size_t weight;      /* views plus properties, the statements the function holds */
+    size_t chunk;       /* source it is written to, 0 is the module source itself */
+} Cut;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* Picks the largest subtrees that fit one chunk's share and spreads them over chunkCount sources,
+   mainTree is false when _Create does not unroll the tree and only the Realize functions are cut */
+void CollectCuts(const TreeNode* rootNode, size_t chunkCount, bool mainTree);
+void ClearCuts(void);
+
+/* In document order */
+size_t GetCutCount(void);
+const Cut* GetCut(size_t index);
+
+/* The cut a node starts, NULL if it is built inline */
+const Cut* FindCut(const TreeNode* node);
+
+#endif /* SPLIT_H */
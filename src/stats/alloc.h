@@ -0,0 +1,41 @@
+/***************************************************************
+**
+** NanoKit Tool Header File
+**
+** File         :  alloc.h
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  Routes heap calls through the stats counters
+**
+***************************************************************/
+
+/* Include after <stdlib.h>, every core source does so the counts cover parsing and emission */
+
+#ifndef ALLOC_H
+#define ALLOC_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stddef.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define malloc(size) StatsMalloc(size)
+#define calloc(count, size) StatsCalloc(count, size)
+#define realloc(pointer, size) StatsRealloc(pointer, size)
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+void* StatsMalloc(size_t size);
+void* StatsCalloc(size_t count, size_t size);
+void* StatsRealloc(void* pointer, size_t size);
+
+#endif /* ALLOC_H */
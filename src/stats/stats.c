@@ -0,0 +1,135 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  stats.c
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen timing and counting helpers
+**
+***************************************************************/
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <time.h>
+#include <sys/resource.h>
+#endif
+
+#include "stats.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static size_t allocationCount = 0;
+static size_t allocationBytes = 0;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+double StatsNow(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#endif
+}
+
+void StatsCountTree(const TreeNode* rootNode, size_t* nodeCount, size_t* propertyCount)
+{
+    /* siblings are walked in a loop so very wide panels cannot exhaust the stack */
+    for (const TreeNode* node = rootNode; node != NULL; node = node->sibling)
+    {
+        (*nodeCount)++;
+
+        for (const NodeProperty* property = node->properties; property != NULL; property = property->next)
+        {
+            (*propertyCount)++;
+        }
+
+        StatsCountTree(node->child, nodeCount, propertyCount);
+    }
+}
+
+void StatsGetAllocations(size_t* count, size_t* bytes)
+{
+    *count = allocationCount;
+    *bytes = allocationBytes;
+}
+
+size_t StatsPeakRss(void)
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return (size_t)counters.PeakWorkingSetSize;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return (size_t)usage.ru_maxrss; /* bytes on Darwin */
+#else
+    return (size_t)usage.ru_maxrss * 1024; /* kilobytes elsewhere */
+#endif
+#endif
+}
+
+void* StatsMalloc(size_t size)
+{
+    allocationCount++;
+    allocationBytes += size;
+    return malloc(size);
+}
+
+void* StatsCalloc(size_t count, size_t size)
+{
+    allocationCount++;
+    allocationBytes += count * size;
+    return calloc(count, size);
+}
+
+void* StatsRealloc(void* pointer, size_t size)
+{
+    allocationCount++;
+    allocationBytes += size;
+    return realloc(pointer, size);
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
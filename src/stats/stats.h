@@ -0,0 +1,49 @@
+/***************************************************************
+**
+** NanoKit Tool Header File
+**
+** File         :  stats.h
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen timing and counting helpers
+**
+***************************************************************/
+
+#ifndef STATS_H
+#define STATS_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <parser/parser.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* Monotonic clock in seconds */
+double StatsNow(void);
+
+void StatsCountTree(const TreeNode* rootNode, size_t* nodeCount, size_t* propertyCount);
+
+/* Heap calls and requested bytes since startup, see alloc.h */
+void StatsGetAllocations(size_t* allocationCount, size_t* allocationBytes);
+
+/* Peak resident set size of the process in bytes, 0 where unsupported */
+size_t StatsPeakRss(void);
+
+#endif /* STATS_H */
@@ -0,0 +1,440 @@
+/***************************************************************
+**
+** NanoKit Tool Source File
+**
+** File         :  theme.c
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen {ThemeResource Key} collection
+**
+***************************************************************/
+
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stats/alloc.h>
+
+#include <diagnostics/diagnostics.h>
+
+#include "theme.h"
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+#define THEME_RESOURCE_PREFIX "{ThemeResource"
+
+#define THEME_NONE ((size_t)-1)
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/***************************************************************
+** MARK: STATIC VARIABLES
+***************************************************************/
+
+static const TreeNode** themeNodes = NULL;
+static size_t themeCount = 0;
+
+static char** resources = NULL;
+static size_t resourceCount = 0;
+static size_t resourceCapacity = 0;
+
+/* themeCount rows of resourceCount colours, filled once every site is known */
+static uint32_t* values = NULL;
+
+static ThemeSite* sites = NULL;
+static size_t siteCount = 0;
+static size_t siteCapacity = 0;
+
+/***************************************************************
+** MARK: STATIC FUNCTION DEFS
+***************************************************************/
+
+static bool CollectDefinitions(void);
+static bool CollectNode(TreeNode* node, const TreeNode* deferred);
+static bool AddSite(TreeNode* node, NodeProperty* property, const TreeNode* deferred);
+static bool ParseKey(const char* value, char* key, size_t size);
+static bool IsIdentifier(const char* name);
+static bool IsHexColor(const char* value);
+static const NodeProperty* FindDefinition(const TreeNode* theme, const char* key);
+static size_t FindResource(const char* name);
+
+/***************************************************************
+** MARK: PUBLIC FUNCTIONS
+***************************************************************/
+
+bool IsThemeResource(const char* value)
+{
+    size_t length = strlen(THEME_RESOURCE_PREFIX);
+
+    if (!value || strncmp(value, THEME_RESOURCE_PREFIX, length) != 0) return false;
+
+    return value[length] == ' ' || value[length] == '\t' || value[length] == '}';
+}
+
+bool CollectThemes(TreeNode* rootNode)
+{
+    ClearThemes();
+
+    bool valid = CollectDefinitions();
+
+    if (rootNode && !CollectNode(rootNode, NULL))
+    {
+        valid = false;
+    }
+
+    if (!valid) return false;
+
+    if (themeCount > 0 && resourceCount > 0)
+    {
+        values = (uint32_t*)malloc(themeCount * resourceCount * sizeof(uint32_t));
+
+        if (!values) return false;
+
+        for (size_t theme = 0; theme < themeCount; theme++)
+        {
+            for (size_t resource = 0; resource < resourceCount; resource++)
+            {
+                const NodeProperty* definition = FindDefinition(themeNodes[theme], resources[resource]);
+                values[theme * resourceCount + resource] = (uint32_t)strtoul(definition->value + 1, NULL, 16);
+            }
+        }
+    }
+
+    return true;
+}
+
+void ClearThemes(void)
+{
+    for (size_t i = 0; i < resourceCount; i++)
+    {
+        free(resources[i]);
+    }
+
+    free(themeNodes);
+    free(resources);
+    free(values);
+    free(sites);
+
+    themeNodes = NULL;
+    themeCount = 0;
+
+    resources = NULL;
+    resourceCount = 0;
+    resourceCapacity = 0;
+
+    values = NULL;
+
+    sites = NULL;
+    siteCount = 0;
+    siteCapacity = 0;
+}
+
+size_t GetThemeCount(void)
+{
+    return themeCount;
+}
+
+const TreeNode* GetTheme(size_t index)
+{
+    return (index < themeCount) ? themeNodes[index] : NULL;
+}
+
+size_t GetThemeResourceCount(void)
+{
+    return resourceCount;
+}
+
+const char* GetThemeResourceName(size_t index)
+{
+    return (index < resourceCount) ? resources[index] : NULL;
+}
+
+uint32_t GetThemeResourceValue(size_t theme, size_t resource)
+{
+    if (!values || theme >= themeCount || resource >= resourceCount) return 0;
+
+    return values[theme * resourceCount + resource];
+}
+
+size_t GetThemeSiteCount(void)
+{
+    return siteCount;
+}
+
+const ThemeSite* GetThemeSite(size_t index)
+{
+    return (index < siteCount) ? &sites[index] : NULL;
+}
+
+/***************************************************************
+** MARK: STATIC FUNCTIONS
+***************************************************************/
+
+static bool CollectDefinitions(void)
+{
+    bool valid = true;
+
+    for (const TreeNode* theme = GetThemes(); theme != NULL; theme = theme->sibling)
+    {
+        themeCount++;
+    }
+
+    if (themeCount == 0) return true;
+
+    themeNodes = (const TreeNode**)malloc(themeCount * sizeof(const TreeNode*));
+
+    if (!themeNodes)
+    {
+        themeCount = 0;
+        return false;
+    }
+
+    size_t index = 0;
+
+    for (const TreeNode* theme = GetThemes(); theme != NULL; theme = theme->sibling)
+    {
+        themeNodes[index] = theme;
+
+        /* the name becomes an enumerator */
+        if (!IsIdentifier(theme->instanceName))
+        {
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, theme->file, theme->line, theme->column, "theme name '%s' is not a C identifier", theme->instanceName);
+            valid = false;
+        }
+
+        for (size_t i = 0; i < index; i++)
+        {
+            if (strcmp(themeNodes[i]->instanceName, theme->instanceName) == 0)
+            {
+                DiagnosticsReportAt(DIAGNOSTIC_ERROR, theme->file, theme->line, theme->column, "theme '%s' is already declared at %u:%u", theme->instanceName, (unsigned)themeNodes[i]->line, (unsigned)themeNodes[i]->column);
+                valid = false;
+                break;
+            }
+        }
+
+        for (const NodeProperty* property = theme->properties; property != NULL; property = property->next)
+        {
+            /* packed at generation time, named colours are NanoKit macros with no value known here */
+            if (!IsHexColor(property->value))
+            {
+                DiagnosticsReportAt(DIAGNOSTIC_ERROR, theme->file, property->line, property->column, "theme resource '%s' must be a #RRGGBB colour, got '%s'", property->key, property->value);
+                valid = false;
+            }
+
+            if (FindDefinition(theme, property->key) != property)
+            {
+                DiagnosticsReportAt(DIAGNOSTIC_ERROR, theme->file, property->line, property->column, "theme resource '%s' is defined twice in theme '%s'", property->key, theme->instanceName);
+                valid = false;
+            }
+        }
+
+        index++;
+    }
+
+    return valid;
+}
+
+static bool CollectNode(TreeNode* node, const TreeNode* deferred)
+{
+    bool valid = true;
+
+    /* siblings are walked in a loop, only depth recurses */
+    for (; node != NULL; node = node->sibling)
+    {
+        const TreeNode* nodeDeferred = node->deferred ? node : deferred;
+
+        for (NodeProperty* property = node->properties; property != NULL; property = property->next)
+        {
+            if (IsThemeResource(property->value) && !AddSite(node, property, nodeDeferred))
+            {
+                valid = false;
+            }
+        }
+
+        if (node->child && !CollectNode(node->child, nodeDeferred))
+        {
+            valid = false;
+        }
+    }
+
+    return valid;
+}
+
+static bool AddSite(TreeNode* node, NodeProperty* property, const TreeNode* deferred)
+{
+    char key[128];
+
+    if (node->repeatCount)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, property->line, property->column, "'%s' cannot be used on the repeated element '%s', a theme fixup targets a single field", property->value, node->instanceName);
+        return false;
+    }
+
+    if (node->component)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, property->line, property->column, "'%s' cannot be used on the UserControl '%s', theme the component itself instead", property->value, node->instanceName);
+        return false;
+    }
+
+    if (!ParseKey(property->value, key, sizeof(key)))
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, property->line, property->column, "malformed theme resource '%s', expected {ThemeResource Key}", property->value);
+        return false;
+    }
+
+    bool isInherited = false;
+    PropertyType type = ResolvePropertyType(node->className, property->key, &isInherited);
+
+    if (type != TYPE_COLOR)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, property->line, property->column, "theme resources only set colours, '%s' is a %s", property->key, GetTypeCodeName(type));
+        return false;
+    }
+
+    if (themeCount == 0)
+    {
+        DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, property->line, property->column, "theme resource '%s' is used but the module declares no <Theme>", key);
+        return false;
+    }
+
+    size_t resourceIndex = FindResource(key);
+
+    if (resourceIndex == THEME_NONE)
+    {
+        bool defined = true;
+
+        for (size_t i = 0; i < themeCount; i++)
+        {
+            if (!FindDefinition(themeNodes[i], key))
+            {
+                DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, property->line, property->column, "theme '%s' does not define resource '%s'", themeNodes[i]->instanceName, key);
+                defined = false;
+            }
+        }
+
+        if (!defined) return false;
+
+        if (resourceCount == resourceCapacity)
+        {
+            size_t capacity = resourceCapacity ? resourceCapacity * 2 : 16;
+            char** grown = (char**)realloc(resources, capacity * sizeof(char*));
+
+            if (!grown) return false;
+
+            resources = grown;
+            resourceCapacity = capacity;
+        }
+
+        resources[resourceCount] = (char*)malloc(strlen(key) + 1);
+
+        if (!resources[resourceCount]) return false;
+
+        strcpy(resources[resourceCount], key);
+        resourceIndex = resourceCount++;
+    }
+
+    if (siteCount == siteCapacity)
+    {
+        size_t capacity = siteCapacity ? siteCapacity * 2 : 16;
+        ThemeSite* grown = (ThemeSite*)realloc(sites, capacity * sizeof(ThemeSite));
+
+        if (!grown) return false;
+
+        sites = grown;
+        siteCapacity = capacity;
+    }
+
+    ThemeSite* site = &sites[siteCount++];
+
+    site->node = node;
+    site->property = property;
+    site->fieldName = TranslatePropertyName(node->className, property->key);
+    site->isInherited = isInherited;
+    site->deferred = deferred;
+    site->resource = resourceIndex;
+
+    return true;
+}
+
+static bool ParseKey(const char* value, char* key, size_t size)
+{
+    /* {ThemeResource Key}, surrounding blanks allowed */
+    const char* cursor = value + strlen(THEME_RESOURCE_PREFIX);
+
+    while (*cursor == ' ' || *cursor == '\t') cursor++;
+
+    size_t length = 0;
+
+    while (cursor[length] != '\0' && cursor[length] != '}' && cursor[length] != ' ' && cursor[length] != '\t')
+    {
+        length++;
+    }
+
+    if (length == 0 || length >= size) return false;
+
+    memcpy(key, cursor, length);
+    key[length] = '\0';
+
+    cursor += length;
+
+    while (*cursor == ' ' || *cursor == '\t') cursor++;
+
+    return cursor[0] == '}' && cursor[1] == '\0';
+}
+
+static bool IsIdentifier(const char* name)
+{
+    if (!name || name[0] == '\0' || (name[0] >= '0' && name[0] <= '9')) return false;
+
+    for (; *name != '\0'; name++)
+    {
+        if (!((*name >= 'a' && *name <= 'z') || (*name >= 'A' && *name <= 'Z') || (*name >= '0' && *name <= '9') || *name == '_'))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool IsHexColor(const char* value)
+{
+    return value[0] == '#' && strlen(value) == 7 && strspn(value + 1, "0123456789abcdefABCDEF") == 6;
+}
+
+static const NodeProperty* FindDefinition(const TreeNode* theme, const char* key)
+{
+    for (const NodeProperty* property = theme->properties; property != NULL; property = property->next)
+    {
+        if (strcmp(property->key, key) == 0)
+        {
+            return property;
+        }
+    }
+
+    return NULL;
+}
+
+static size_t FindResource(const char* name)
+{
+    for (size_t i = 0; i < resourceCount; i++)
+    {
+        if (strcmp(resources[i], name) == 0)
+        {
+            return i;
+        }
+    }
+
+    return THEME_NONE;
+}
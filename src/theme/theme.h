@@ -0,0 +1,73 @@
+/***************************************************************
+**
+** NanoKit Tool Header File
+**
+** File         :  theme.h
+** Module       :  nkgen
+** Author       :  SH
+** Created      :  2026-10-18 (YYYY-MM-DD)
+** License      :  MIT
+** Description  :  nkgen {ThemeResource Key} collection
+**
+***************************************************************/
+
+#ifndef THEME_H
+#define THEME_H
+
+/***************************************************************
+** MARK: INCLUDES
+***************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <parser/parser.h>
+#include <translator/translator.h>
+
+/***************************************************************
+** MARK: CONSTANTS & MACROS
+***************************************************************/
+
+/***************************************************************
+** MARK: TYPEDEFS
+***************************************************************/
+
+/* One attribute set from the current theme */
+typedef struct
+{
+    const TreeNode* node;
+    const NodeProperty* property;
+    const char* fieldName;      /* translated property name, under .view when inherited */
+    bool isInherited;
+
+    const TreeNode* deferred;   /* nearest deferred node at or above the site, NULL if _Create builds it */
+
+    size_t resource;            /* column of the resource table */
+} ThemeSite;
+
+/***************************************************************
+** MARK: FUNCTION DEFS
+***************************************************************/
+
+/* True for "{ThemeResource ...}", writers leave these attributes to the theme code */
+bool IsThemeResource(const char* value);
+
+/* Gathers the <Theme> elements and the attributes using them, reports unknown keys and unsupported values */
+bool CollectThemes(TreeNode* rootNode);
+void ClearThemes(void);
+
+size_t GetThemeCount(void);
+const TreeNode* GetTheme(size_t index);
+
+/* Only resources some view uses get a column, in first use order */
+size_t GetThemeResourceCount(void);
+const char* GetThemeResourceName(size_t index);
+
+/* The resource as a 0xRRGGBB colour */
+uint32_t GetThemeResourceValue(size_t theme, size_t resource);
+
+size_t GetThemeSiteCount(void);
+const ThemeSite* GetThemeSite(size_t index);
+
+#endif /* THEME_H */
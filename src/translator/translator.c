@@ -19,8 +19,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+
+#include <stats/alloc.h>
 
 #include <xml/xml.h>
+#include <diagnostics/diagnostics.h>
+#include <pool/pool.h>
+#include <binding/binding.h>
+#include <theme/theme.h>
 
 #include "translator.h"
 
@@ -28,18 +35,22 @@
 ** MARK: CONSTANTS & MACROS
 ***************************************************************/
 
+#define INDEX_KEYWORD "Index"
+
 /***************************************************************
 ** MARK: TYPEDEFS
 ***************************************************************/
 
-typedef void(*WriterFunction)(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile);
+typedef void(*WriterFunction)(PropertyType propertyType, const char* propertyValue, OutputBuffer* output);
 
 typedef struct
 {
     const char* typeName;
     const char* codeName;
     WriterFunction declarationWriter;
-    WriterFunction valueWriter;
+    WriterFunction valueWriter;         /* writes the value as a C expression */
+    const char* constantMember;         /* member of the table backend's value union, NULL when the value needs runtime code */
+    ValueComparison comparison;         /* how binding setters detect a change */
 } CodeType;
 
 typedef struct 
@@ -64,37 +75,37 @@ typedef struct ClassEntry
 ** MARK: STATIC VARIABLES
 ***************************************************************/
 
-void CallbackDeclarationWriter(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile);
+void CallbackDeclarationWriter(PropertyType propertyType, const char* propertyValue, OutputBuffer* output);
 
-void StringWriter(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile);
+void StringWriter(PropertyType propertyType, const char* propertyValue, OutputBuffer* output);
 
-void FloatWriter(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile);
+void FloatWriter(PropertyType propertyType, const char* propertyValue, OutputBuffer* output);
 
-void ColorWriter(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile);
+void ColorWriter(PropertyType propertyType, const char* propertyValue, OutputBuffer* output);
 
 
-void VerticalAlignmentWriter(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile);
+void VerticalAlignmentWriter(PropertyType propertyType, const char* propertyValue, OutputBuffer* output);
 
-void HorizontalAlignmentWriter(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile);
+void HorizontalAlignmentWriter(PropertyType propertyType, const char* propertyValue, OutputBuffer* output);
 
 
-void DockPositionWriter(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile);
+void DockPositionWriter(PropertyType propertyType, const char* propertyValue, OutputBuffer* output);
 
-void StackOrientationWriter(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile);
+void StackOrientationWriter(PropertyType propertyType, const char* propertyValue, OutputBuffer* output);
 
 
 static CodeType codeTypes[] = {
-    [TYPE_STRING] = {"STRING", "const char*", NULL, StringWriter},
-    [TYPE_FLOAT] = {"FLOAT", "float", NULL, FloatWriter},
-    [TYPE_THICKNESS] = {"THICKNESS", "nkThickness_t", NULL, NULL},
-    [TYPE_COLOR] = {"COLOR", "nkColor_t", NULL, ColorWriter},
-    [TYPE_BOOLEAN] = {"BOOLEAN", "bool", NULL, NULL},
-    [TYPE_VERTICAL_ALIGNMENT] = {"VERTICAL_ALIGNMENT", "nkHorizontalAlignment_t", NULL, VerticalAlignmentWriter},
-    [TYPE_HORIZONTAL_ALIGNMENT] = {"HORIZONTAL_ALIGNMENT", "nkVerticalAlignment_t", NULL, HorizontalAlignmentWriter},
-    [TYPE_DOCK_POSITION] = {"DOCK_POSITION", "nkDockPosition_t", NULL, DockPositionWriter},
-    [TYPE_STACK_ORIENTATION] = {"STACK_ORIENTATION", "nkStackOrientation_t", NULL, StackOrientationWriter},
-    [TYPE_GENERIC_CALLBACK] = {"GENERIC_CALLBACK", "ViewMeasureCallback_t", CallbackDeclarationWriter, NULL},
-    [TYPE_BUTTON_CALLBACK] = {"BUTTON_CALLBACK", "ButtonCallback_t", CallbackDeclarationWriter, NULL},
+    [TYPE_STRING] = {"STRING", "const char*", NULL, StringWriter, "string", COMPARE_STRING},
+    [TYPE_FLOAT] = {"FLOAT", "float", NULL, FloatWriter, "number", COMPARE_VALUE},
+    [TYPE_THICKNESS] = {"THICKNESS", "nkThickness_t", NULL, NULL, NULL, COMPARE_MEMORY},
+    [TYPE_COLOR] = {"COLOR", "nkColor_t", NULL, ColorWriter, NULL, COMPARE_MEMORY},
+    [TYPE_BOOLEAN] = {"BOOLEAN", "bool", NULL, NULL, NULL, COMPARE_VALUE},
+    [TYPE_VERTICAL_ALIGNMENT] = {"VERTICAL_ALIGNMENT", "nkVerticalAlignment_t", NULL, VerticalAlignmentWriter, "enumeration", COMPARE_VALUE},
+    [TYPE_HORIZONTAL_ALIGNMENT] = {"HORIZONTAL_ALIGNMENT", "nkHorizontalAlignment_t", NULL, HorizontalAlignmentWriter, "enumeration", COMPARE_VALUE},
+    [TYPE_DOCK_POSITION] = {"DOCK_POSITION", "nkDockPosition_t", NULL, DockPositionWriter, "enumeration", COMPARE_VALUE},
+    [TYPE_STACK_ORIENTATION] = {"STACK_ORIENTATION", "nkStackOrientation_t", NULL, StackOrientationWriter, "enumeration", COMPARE_VALUE},
+    [TYPE_GENERIC_CALLBACK] = {"GENERIC_CALLBACK", "ViewMeasureCallback_t", CallbackDeclarationWriter, NULL, "callback", COMPARE_VALUE},
+    [TYPE_BUTTON_CALLBACK] = {"BUTTON_CALLBACK", "ButtonCallback_t", CallbackDeclarationWriter, NULL, "callback", COMPARE_VALUE},
 };
 
 static PropertyEntry nkWindowProperties[] = {
@@ -138,6 +149,11 @@ static PropertyEntry nkLabelProperties[] = {
     { NULL, NULL, TYPE_STRING } /* NULL TERMINATION */
 };
 
+/* only the View properties it inherits, they are written to the super member of the component */
+static PropertyEntry nkUserControlProperties[] = {
+    { NULL, NULL, TYPE_STRING } /* NULL TERMINATION */
+};
+
 static PropertyEntry nkButtonProperties[] = {
     { "Content", "text", TYPE_STRING },
     { "Text", "text", TYPE_STRING },
@@ -156,6 +172,9 @@ static ClassEntry classes[] = {
     {"ScrollViewer", "nkScrollView_t", "nkScrollView_Create", nkScrollViewProperties, &classes[1]},
     {"TextBlock", "nkLabel_t", "nkLabel_Create", nkLabelProperties, &classes[1]},
     {"Button", "nkButton_t", "nkButton_Create", nkButtonProperties, &classes[1]},
+    {"ItemsControl", "nkStackView_t", "nkStackView_Create", nkStackViewProperties, &classes[1]}, /* rows from its ItemTemplate */
+    {"ListView", "nkStackView_t", "nkStackView_Create", nkStackViewProperties, &classes[1]},
+    {"UserControl", "nkView_t", "nkView_Create", nkUserControlProperties, &classes[1]}, /* the Class module's struct and _Create are used instead */
     {NULL, NULL, NULL, NULL, TYPE_STRING} /* NULL TERMINATION */
 };
 
@@ -164,6 +183,9 @@ static ClassEntry classes[] = {
 ** MARK: STATIC FUNCTION DEFS
 ***************************************************************/
 
+static bool ParseIndexExpression(const char* value, OutputBuffer* output);
+static bool MentionsIndex(const char* value);
+
 /***************************************************************
 ** MARK: PUBLIC FUNCTIONS
 ***************************************************************/
@@ -172,39 +194,80 @@ bool ValidateTree(TreeNode* rootNode)
 {
     if (!rootNode) return false;
 
-    if (!ValidateClass(rootNode->className))
-    {
-        return false;
-    }
+    bool valid = true;
 
-    NodeProperty* property = rootNode->properties;
-    while (property)
+    /* siblings are walked in a loop so very wide panels cannot exhaust the stack,
+       and validation carries on after an error so every problem is reported at once */
+    for (TreeNode* node = rootNode; node != NULL; node = node->sibling)
     {
-        if (!ValidateProperty(rootNode->className, property->key))
+        if (!ValidateClass(node->className))
         {
-            return false;
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, node->line, node->column, "unknown class '%s'", node->className);
+            valid = false;
+            continue;
         }
 
-        property = property->next;
-    }
+        if (node->repeatCount && (node->deferred || node->items))
+        {
+            /* a repeated element is one member array, per node machinery has nowhere to live for each copy */
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, node->line, node->column, node->deferred ? "repeated element '%s' cannot be deferred" : "%s cannot be repeated", node->deferred ? node->instanceName : node->className);
+            valid = false;
+        }
 
-    if (rootNode->child)
-    {
-        if (!ValidateTree(rootNode->child))
+        NodeProperty* property = node->properties;
+        while (property)
         {
-            return false;
+            if (!ValidateProperty(node->className, property->key))
+            {
+                DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, property->line, property->column, "unknown property '%s' for class '%s'", property->key, node->className);
+                valid = false;
+            }
+            else if (IsIndexExpression(property->value))
+            {
+                bool isInherited = false;
+
+                if (!node->repeatCount)
+                {
+                    DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, property->line, property->column, "'%s' is only available inside a Repeat", property->value);
+                    valid = false;
+                }
+                else if (ResolvePropertyType(node->className, property->key, &isInherited) != TYPE_FLOAT)
+                {
+                    DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, property->line, property->column, "index expressions are only supported on numeric properties, '%s' is not one", property->key);
+                    valid = false;
+                }
+            }
+            else if (MentionsIndex(property->value))
+            {
+                DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->file, property->line, property->column, "malformed index expression '%s', expected {Index} with numbers, + - * / %% and parentheses", property->value);
+                valid = false;
+            }
+
+            property = property->next;
         }
-    }
 
-    if (rootNode->sibling)
-    {
-        if (!ValidateTree(rootNode->sibling))
+        if (node->items && node->items->root && node->items->root->component)
         {
-            return false;
+            /* the row struct links its root to the list directly */
+            DiagnosticsReportAt(DIAGNOSTIC_ERROR, node->items->root->file, node->items->root->line, node->items->root->column, "the ItemTemplate of %s cannot be a UserControl, place it in a panel", node->className);
+            valid = false;
+        }
+
+        if (node->items && node->items->root && !ValidateTree(node->items->root))
+        {
+            valid = false;
+        }
+
+        if (node->child)
+        {
+            if (!ValidateTree(node->child))
+            {
+                valid = false;
+            }
         }
     }
 
-    return true;
+    return valid;
 }
 
 bool ValidateClass(const char* className)
@@ -218,8 +281,6 @@ bool ValidateClass(const char* className)
         }
     }
 
-    printf("Error: Unknown class '%s'\n", className);
-
     return false;
 }
 
@@ -239,7 +300,6 @@ bool ValidateProperty(const char* className, const char* propertyName)
 
     if (!classEntry)
     {
-        printf("Error: Unknown class '%s'\n", className);
         return false;
     }
 
@@ -270,7 +330,6 @@ bool ValidateProperty(const char* className, const char* propertyName)
         }
     }
 
-    printf("Error: Unknown property '%s' for class '%s'\n", propertyName, className);
     return false;
 }
 
@@ -284,7 +343,7 @@ const char* TranslateClassName(const char* className)
         }
     }
 
-    printf("Error: Unknown class '%s'\n", className);
+    DiagnosticsReport(DIAGNOSTIC_ERROR, "unknown class '%s'", className);
     return "[UNKNOWN]";
 }
 
@@ -298,7 +357,7 @@ const char* TranslateSuperConstructor(const char* className)
         }
     }
 
-    printf("Error: Unknown class '%s'\n", className);
+    DiagnosticsReport(DIAGNOSTIC_ERROR, "unknown class '%s'", className);
     return "[UNKNOWN]";
 }
 
@@ -318,7 +377,7 @@ PropertyType ResolvePropertyType(const char* className, const char* propertyName
 
     if (!classEntry)
     {
-        printf("Error: Unknown class '%s'\n", className);
+        DiagnosticsReport(DIAGNOSTIC_ERROR, "unknown class '%s'", className);
         return TYPE_STRING;
     }
 
@@ -352,7 +411,7 @@ PropertyType ResolvePropertyType(const char* className, const char* propertyName
         }
     }
 
-    printf("Error: Unknown property '%s' for class '%s'\n", propertyName, className);
+    DiagnosticsReport(DIAGNOSTIC_ERROR, "unknown property '%s' for class '%s'", propertyName, className);
     return TYPE_STRING;
 }
 
@@ -371,7 +430,7 @@ const char* TranslatePropertyName(const char* className, const char* propertyNam
 
     if (!classEntry)
     {
-        printf("Error: Unknown class '%s'\n", className);
+        DiagnosticsReport(DIAGNOSTIC_ERROR, "unknown class '%s'", className);
         return "[ERROR]";
     }
 
@@ -402,30 +461,69 @@ const char* TranslatePropertyName(const char* className, const char* propertyNam
         }
     }
 
-    printf("Error: Unknown property '%s' for class '%s'\n", propertyName, className);
+    DiagnosticsReport(DIAGNOSTIC_ERROR, "unknown property '%s' for class '%s'", propertyName, className);
     return "[ERROR]";
 }
 
-void DeclareCallback(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile)
+void DeclareCallback(PropertyType propertyType, const char* propertyValue, OutputBuffer* output)
 {
     if (propertyType >= TYPE_GENERIC_CALLBACK)
     {
-        CallbackDeclarationWriter(propertyType, propertyValue, outputBuffer, outputBufferSize, positionInFile);
+        CallbackDeclarationWriter(propertyType, propertyValue, output);
     }
 }
 
-void WriteValue(PropertyType type, const char* value, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile)
+void WriteCallbackCall(PropertyType propertyType, const char* propertyValue, const char* sender, OutputBuffer* output)
 {
-    if (type < sizeof(codeTypes) / sizeof(CodeType))
+    /* the same arguments CallbackDeclarationWriter declares */
+    switch (propertyType)
+    {
+        case TYPE_BUTTON_CALLBACK:
+        {
+            BufferPrintf(output,
+                "%s((nkButton_t *)%s)",
+                propertyValue,
+                sender
+            );
+        } break;
+
+        default:
+        {
+            BufferPrintf(output,
+                "%s()",
+                propertyValue
+            );
+        } break;
+    }
+}
+
+bool IsIndexExpression(const char* value)
+{
+    return ParseIndexExpression(value, NULL);
+}
+
+void WriteValue(PropertyType type, const char* value, OutputBuffer* output)
+{
+    if (type < PROPERTY_TYPE_COUNT)
+    {
+        WriteExpression(type, value, output);
+
+        BufferPrintf(output, ";\n");
+    }
+}
+
+void WriteExpression(PropertyType type, const char* value, OutputBuffer* output)
+{
+    if (type < PROPERTY_TYPE_COUNT)
     {
         if (codeTypes[type].valueWriter)
         {
-            codeTypes[type].valueWriter(type, value, outputBuffer, outputBufferSize, positionInFile);
+            codeTypes[type].valueWriter(type, value, output);
         }
         else
         {
-            *positionInFile += snprintf(outputBuffer + *positionInFile, outputBufferSize - *positionInFile,
-                "(%s)%s;\n",
+            BufferPrintf(output,
+                "(%s)%s",
                 codeTypes[type].codeName,
                 value
             );
@@ -433,18 +531,147 @@ void WriteValue(PropertyType type, const char* value, char* outputBuffer, size_t
     }
 }
 
+bool WriteConstant(PropertyType type, const char* value, OutputBuffer* output)
+{
+    if (type >= PROPERTY_TYPE_COUNT || !codeTypes[type].constantMember) return false;
+
+    BufferPrintf(output, "{ .%s = ", codeTypes[type].constantMember);
+
+    if (type >= TYPE_GENERIC_CALLBACK)
+    {
+        /* every callback shares one pointer type in the union */
+        BufferPrintf(output, "(void (*)(void))%s", value);
+    }
+    else
+    {
+        WriteExpression(type, value, output);
+    }
+
+    BufferPrintf(output, " }");
+
+    return true;
+}
+
+void WriteColorPacking(OutputBuffer* output)
+{
+    /* assumes float channels in 0..1, a NanoKit build with another nkColor_t layout overrides this */
+    BufferPrintf(output,
+"#ifndef NKGEN_COLOR_RGBA\n\
+#define NKGEN_COLOR_RGBA(R, G, B, A) { .r = (R) / 255.0f, .g = (G) / 255.0f, .b = (B) / 255.0f, .a = (A) / 255.0f }\n\
+#endif\n\
+\n"
+    );
+}
+
+void WritePackedColor(uint32_t rgb, OutputBuffer* output)
+{
+    BufferPrintf(output,
+        "NKGEN_COLOR_RGBA(0x%02x, 0x%02x, 0x%02x, 0xff)",
+        (unsigned)((rgb >> 16) & 0xFF),
+        (unsigned)((rgb >> 8) & 0xFF),
+        (unsigned)(rgb & 0xFF)
+    );
+}
+
+const char* GetTypeCodeName(PropertyType type)
+{
+    return (type < PROPERTY_TYPE_COUNT) ? codeTypes[type].codeName : NULL;
+}
+
+const char* GetConstantMember(PropertyType type)
+{
+    return (type < PROPERTY_TYPE_COUNT) ? codeTypes[type].constantMember : NULL;
+}
+
+ValueComparison GetTypeComparison(PropertyType type)
+{
+    return (type < PROPERTY_TYPE_COUNT) ? codeTypes[type].comparison : COMPARE_VALUE;
+}
+
+bool IsPropertyTypeUsed(PropertyType type)
+{
+    for (size_t i = 0; classes[i].markupName != NULL; i++)
+    {
+        for (size_t j = 0; classes[i].properties[j].markupName != NULL; j++)
+        {
+            if (classes[i].properties[j].type == type) return true;
+        }
+    }
+
+    return false;
+}
+
+size_t GetClassCount(void)
+{
+    return sizeof(classes) / sizeof(ClassEntry) - 1;
+}
+
+const char* GetClassMarkupName(size_t index)
+{
+    return (index < GetClassCount()) ? classes[index].markupName : NULL;
+}
+
+size_t GetClassIndex(const char* className)
+{
+    for (size_t i = 0; classes[i].markupName != NULL; i++)
+    {
+        if (strcmp(classes[i].markupName, className) == 0)
+        {
+            return i;
+        }
+    }
+
+    DiagnosticsReport(DIAGNOSTIC_ERROR, "unknown class '%s'", className);
+    return 0;
+}
+
+size_t GetPropertyOrder(const char* className, const char* propertyName)
+{
+    size_t classIndex = GetClassIndex(className);
+    const ClassEntry* classEntry = &classes[classIndex];
+
+    /* the super struct is the first member, its fields come before the class's own */
+    size_t superCount = 0;
+
+    if (classEntry->super)
+    {
+        while (classEntry->super->properties[superCount].markupName != NULL) superCount++;
+    }
+
+    for (size_t i = 0; classEntry->properties[i].markupName != NULL; i++)
+    {
+        if (strcmp(classEntry->properties[i].markupName, propertyName) == 0)
+        {
+            return superCount + i;
+        }
+    }
+
+    if (classEntry->super)
+    {
+        for (size_t i = 0; classEntry->super->properties[i].markupName != NULL; i++)
+        {
+            if (strcmp(classEntry->super->properties[i].markupName, propertyName) == 0)
+            {
+                return i;
+            }
+        }
+    }
+
+    return SIZE_MAX;
+}
+
 
 /***************************************************************
 ** MARK: STATIC FUNCTIONS
 ***************************************************************/
 
-void CallbackDeclarationWriter(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile)
+void CallbackDeclarationWriter(PropertyType propertyType, const char* propertyValue, OutputBuffer* output)
 {
     switch (propertyType)
     {
         case TYPE_BUTTON_CALLBACK:
         {
-            *positionInFile += snprintf(outputBuffer + *positionInFile, outputBufferSize - *positionInFile,
+            BufferPrintf(output,
                 "void %s(nkButton_t *button);\n",
                 propertyValue
             );
@@ -452,7 +679,7 @@ void CallbackDeclarationWriter(PropertyType propertyType, const char* propertyVa
         
         default:
         {
-            *positionInFile += snprintf(outputBuffer + *positionInFile, outputBufferSize - *positionInFile,
+            BufferPrintf(output,
                 "void %s();\n",
                 propertyValue
             );
@@ -461,23 +688,40 @@ void CallbackDeclarationWriter(PropertyType propertyType, const char* propertyVa
 }
 
 
-void StringWriter(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile)
+void StringWriter(PropertyType propertyType, const char* propertyValue, OutputBuffer* output)
 {
-    *positionInFile += snprintf(outputBuffer + *positionInFile, outputBufferSize - *positionInFile,
-        "\"%s\";\n",
+    const char* pooled = PoolString(propertyValue);
+
+    if (pooled)
+    {
+        BufferPrintf(output, "%s", pooled);
+        return;
+    }
+
+    BufferPrintf(output,
+        "\"%s\"",
         propertyValue
     );
 }
 
-void FloatWriter(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile)
+void FloatWriter(PropertyType propertyType, const char* propertyValue, OutputBuffer* output)
 {
-    *positionInFile += snprintf(outputBuffer + *positionInFile, outputBufferSize - *positionInFile,
-        "(float)%s;\n",
+    if (IsIndexExpression(propertyValue))
+    {
+        /* evaluated in int so subtracting the index cannot wrap */
+        BufferPrintf(output, "(float)(");
+        ParseIndexExpression(propertyValue, output);
+        BufferPrintf(output, ")");
+        return;
+    }
+
+    BufferPrintf(output,
+        "(float)%s",
         propertyValue
     );
 }
 
-void VerticalAlignmentWriter(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile)
+void VerticalAlignmentWriter(PropertyType propertyType, const char* propertyValue, OutputBuffer* output)
 {
     const char* alignment = "";
 
@@ -497,20 +741,20 @@ void VerticalAlignmentWriter(PropertyType propertyType, const char* propertyValu
     {
         if (strcmp(propertyValue, "Stretch") != 0)
         {
-            printf("Error: Unknown vertical alignment '%s'. Defaulting to fill.\n", propertyValue);
+            DiagnosticsReport(DIAGNOSTIC_WARNING, "unknown vertical alignment '%s', defaulting to Stretch", propertyValue);
         }
 
         alignment = "ALIGNMENT_FILL";
     }
 
-    *positionInFile += snprintf(outputBuffer + *positionInFile, outputBufferSize - *positionInFile,
-        "%s;\n",
+    BufferPrintf(output,
+        "%s",
         alignment
     );
  
 }
 
-void HorizontalAlignmentWriter(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile)
+void HorizontalAlignmentWriter(PropertyType propertyType, const char* propertyValue, OutputBuffer* output)
 {
     const char* alignment = "";
 
@@ -530,19 +774,19 @@ void HorizontalAlignmentWriter(PropertyType propertyType, const char* propertyVa
     {
         if (strcmp(propertyValue, "Stretch") != 0)
         {
-            printf("Error: Unknown vertical alignment '%s'. Defaulting to stretch.\n", propertyValue);
+            DiagnosticsReport(DIAGNOSTIC_WARNING, "unknown horizontal alignment '%s', defaulting to Stretch", propertyValue);
         }
 
         alignment = "ALIGNMENT_STRETCH";
     }
 
-    *positionInFile += snprintf(outputBuffer + *positionInFile, outputBufferSize - *positionInFile,
-        "%s;\n",
+    BufferPrintf(output,
+        "%s",
         alignment
     );
 }
 
-void DockPositionWriter(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile)
+void DockPositionWriter(PropertyType propertyType, const char* propertyValue, OutputBuffer* output)
 {
     const char* position = NULL;
 
@@ -562,19 +806,19 @@ void DockPositionWriter(PropertyType propertyType, const char* propertyValue, ch
     {
         if (strcmp(propertyValue, "Left") != 0)
         {
-            printf("Error: Unknown dock position '%s'. Defaulting to left.\n", propertyValue);
+            DiagnosticsReport(DIAGNOSTIC_WARNING, "unknown dock position '%s', defaulting to Left", propertyValue);
         }
 
         position = "DOCK_POSITION_LEFT"; // Default to left if not recognized
     }
 
-    *positionInFile += snprintf(outputBuffer + *positionInFile, outputBufferSize - *positionInFile,
-        "%s;\n",
+    BufferPrintf(output,
+        "%s",
         position
     );
 }
 
-void StackOrientationWriter(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile)
+void StackOrientationWriter(PropertyType propertyType, const char* propertyValue, OutputBuffer* output)
 {
     const char* orientation = NULL;
 
@@ -587,20 +831,20 @@ void StackOrientationWriter(PropertyType propertyType, const char* propertyValue
 
         if (strcmp(propertyValue, "Horizontal") != 0)
         {
-            printf("Error: Unknown stack orientation '%s'. Defaulting to horizontal.\n", propertyValue);
+            DiagnosticsReport(DIAGNOSTIC_WARNING, "unknown stack orientation '%s', defaulting to Horizontal", propertyValue);
         } 
 
         orientation = "STACK_ORIENTATION_HORIZONTAL"; // Default to left if not recognized
     }
 
-    *positionInFile += snprintf(outputBuffer + *positionInFile, outputBufferSize - *positionInFile,
-        "%s;\n",
+    BufferPrintf(output,
+        "%s",
         orientation
     );
 }
 
 
-void ColorWriter(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile)
+void ColorWriter(PropertyType propertyType, const char* propertyValue, OutputBuffer* output)
 {
     const char* namedColor = NULL;
 
@@ -664,18 +908,72 @@ void ColorWriter(PropertyType propertyType, const char* propertyValue, char* out
 
     if (namedColor)
     {
-        *positionInFile += snprintf(outputBuffer + *positionInFile, outputBufferSize - *positionInFile,
-            "%s;\n",
+        BufferPrintf(output,
+            "%s",
             namedColor
         );
     }
+    else if (PoolEnabled() && strlen(propertyValue) == 7 && strspn(propertyValue + 1, "0123456789abcdefABCDEF") == 6)
+    {
+        /* packed once into the module pool instead of converted per view */
+        BufferPrintf(output,
+            "%s",
+            PoolColor((uint32_t)strtoul(propertyValue + 1, NULL, 16))
+        );
+    }
     else 
     {
         /* Convert hex color code to nkColor_t */
-        *positionInFile += snprintf(outputBuffer + *positionInFile, outputBufferSize - *positionInFile,
-            "nkColor_FromHexRGB(0x%x);\n",
+        BufferPrintf(output,
+            "nkColor_FromHexRGB(0x%x)",
             (unsigned int)strtol(propertyValue + 1, NULL, 16) // Skip the '#' character
         );
     }
 
 }
+
+static bool ParseIndexExpression(const char* value, OutputBuffer* output)
+{
+    size_t length = value ? strlen(value) : 0;
+
+    if (length < 2 || value[0] != '{' || value[length - 1] != '}') return false;
+
+    bool hasIndex = false;
+    size_t keywordLength = strlen(INDEX_KEYWORD);
+
+    for (size_t i = 1; i < length - 1; i++)
+    {
+        char c = value[i];
+
+        if (isalpha((unsigned char)c) || c == '_')
+        {
+            /* Index is the only identifier, anything else would reach the C compiler unchecked */
+            size_t end = i;
+            while (end < length - 1 && (isalnum((unsigned char)value[end]) || value[end] == '_')) end++;
+
+            if (end - i != keywordLength || strncmp(value + i, INDEX_KEYWORD, keywordLength) != 0) return false;
+
+            if (output) BufferPrintf(output, "(int)index");
+
+            hasIndex = true;
+            i = end - 1;
+        }
+        else if (isdigit((unsigned char)c) || strchr(" \t.+-*/%()", c))
+        {
+            if (output) BufferPrintf(output, "%c", c);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return hasIndex;
+}
+
+static bool MentionsIndex(const char* value)
+{
+    const char* found = value ? strstr(value, INDEX_KEYWORD) : NULL;
+
+    return found && value[0] == '{' && !IsBinding(value) && !IsThemeResource(value);
+}
@@ -22,6 +22,7 @@
 #include <stdbool.h>
 
 #include <parser/parser.h>
+#include <buffer/buffer.h>
 
 /***************************************************************
 ** MARK: CONSTANTS & MACROS
@@ -48,6 +49,16 @@ typedef enum
     TYPE_BUTTON_CALLBACK
 } PropertyType;
 
+#define PROPERTY_TYPE_COUNT (TYPE_BUTTON_CALLBACK + 1)
+
+/* How generated binding setters decide a value changed */
+typedef enum
+{
+    COMPARE_VALUE,      /* scalars, enums and function pointers with != */
+    COMPARE_STRING,     /* strcmp, NULL only equals NULL */
+    COMPARE_MEMORY      /* structs with memcmp */
+} ValueComparison;
+
 /***************************************************************
 ** MARK: FUNCTION DEFS
 ***************************************************************/
@@ -62,8 +73,38 @@ const char* TranslateSuperConstructor(const char* className);
 PropertyType ResolvePropertyType(const char* className, const char* propertyName, bool *isInherited);
 const char* TranslatePropertyName(const char* className, const char* propertyName);
 
-void DeclareCallback(PropertyType propertyType, const char* propertyValue, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile);
+void DeclareCallback(PropertyType propertyType, const char* propertyValue, OutputBuffer* output);
+
+/* A direct call of a callback, sender is the expression passed as the view */
+void WriteCallbackCall(PropertyType propertyType, const char* propertyValue, const char* sender, OutputBuffer* output);
+
+/* {Index ...} arithmetic on a FLOAT property of a repeated element, evaluated with the loop index */
+bool IsIndexExpression(const char* value);
+
+void WriteValue(PropertyType type, const char* value, OutputBuffer* output);
+void WriteExpression(PropertyType type, const char* value, OutputBuffer* output);
+
+/* Table backend: writes a value union initializer, false if the value has to be assigned at runtime */
+bool WriteConstant(PropertyType type, const char* value, OutputBuffer* output);
+
+/* Colours packed at generation time: the guarded NKGEN_COLOR_RGBA definition, then one initializer per colour */
+void WriteColorPacking(OutputBuffer* output);
+void WritePackedColor(uint32_t rgb, OutputBuffer* output);
+
+const char* GetTypeCodeName(PropertyType type);
+const char* GetConstantMember(PropertyType type);
+ValueComparison GetTypeComparison(PropertyType type);
+
+/* True if some class has a property of this type, unused types are left out of generated code */
+bool IsPropertyTypeUsed(PropertyType type);
+
+/* Classes in table order, the index is the class id used by the table backend */
+size_t GetClassCount(void);
+const char* GetClassMarkupName(size_t index);
+size_t GetClassIndex(const char* className);
 
-void WriteValue(PropertyType type, const char* value, char* outputBuffer, size_t outputBufferSize, size_t* positionInFile);
+/* Rank of the property's field in its class struct, inherited View fields first, SIZE_MAX if unknown,
+   the tables list fields in NanoKit's declaration order so adjacent ranks are usually adjacent fields */
+size_t GetPropertyOrder(const char* className, const char* propertyName);
 
 #endif /* TRANSLATOR_H */
\ No newline at end of file
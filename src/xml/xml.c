@@ -37,6 +37,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+/* nkgen: heap calls are counted for the allocation stats */
+#include <stats/alloc.h>
+
 
 
 
@@ -113,6 +116,10 @@ struct xml_node {
 	struct xml_string* content;
 	struct xml_attribute** attributes;
 	struct xml_node** children;
+
+	/* nkgen: cached lengths of the 0-terminated arrays, so lookups are O(1) */
+	size_t attribute_count;
+	size_t child_count;
 };
 
 /**
@@ -176,23 +183,6 @@ static size_t get_zero_terminated_array_attributes(struct xml_attribute** attrib
 
 
 
-/**
- * [PRIVATE]
- *
- * @return Number of nodes in 0-terminated array
- */
-static size_t get_zero_terminated_array_nodes(struct xml_node** nodes) {
-	size_t elements = 0;
-
-	while (nodes[elements]) {
-		++elements;
-	}
-
-	return elements;
-}
-
-
-
 /**
  * [PRIVATE]
  *
@@ -310,6 +300,15 @@ static void xml_parser_info(struct xml_parser* parser, char const* message) {
 
 
 
+/**
+ * [PRIVATE]
+ *
+ * nkgen: receives parser errors instead of stderr when set
+ */
+static xml_error_handler error_handler = 0;
+
+
+
 /**
  * [PRIVATE]
  *
@@ -334,7 +333,9 @@ static void xml_parser_error(struct xml_parser* parser, enum xml_parser_offset o
 		}
 	}
 
-	if (NO_CHARACTER != offset) {
+	if (error_handler) {
+		error_handler(row + 1, column + 1, message);
+	} else if (NO_CHARACTER != offset) {
 		fprintf(stderr,	"xml_parser_error at %i:%i (is %c): %s\n",
 				row + 1, column, parser->buffer[character], message
 		);
@@ -450,13 +451,13 @@ static struct xml_attribute** xml_find_attributes(struct xml_parser* parser, str
 	char* str_content;
 	const unsigned char* start_name;
 	const unsigned char* start_content;
-	size_t old_elements;
-	size_t new_elements;
+	size_t elements = 0;
+	size_t capacity = 4;
 	struct xml_attribute* new_attribute;
 	struct xml_attribute** attributes;
 	int position;
 
-	attributes = calloc(1, sizeof(struct xml_attribute*));
+	attributes = calloc(capacity, sizeof(struct xml_attribute*));
 	attributes[0] = 0;
 
 	tmp = (char*) xml_string_clone(tag_open);
@@ -490,12 +491,14 @@ static struct xml_attribute** xml_find_attributes(struct xml_parser* parser, str
 		new_attribute->content->buffer = (unsigned char*)start_content;
 		new_attribute->content->length = strlen(str_content);
 
-		old_elements = get_zero_terminated_array_attributes(attributes);
-		new_elements = old_elements + 1;
-		attributes = realloc(attributes, (new_elements+1)*sizeof(struct xml_attribute*));
+		/* nkgen: grow geometrically, appending used to recount and realloc every time */
+		if (elements + 2 > capacity) {
+			capacity *= 2;
+			attributes = realloc(attributes, capacity * sizeof(struct xml_attribute*));
+		}
 
-		attributes[new_elements-1] = new_attribute;
-		attributes[new_elements] = 0;
+		attributes[elements++] = new_attribute;
+		attributes[elements] = 0;
 
 
 		free(str_name);
@@ -704,9 +707,11 @@ static struct xml_node* xml_parse_node(struct xml_parser* parser) {
 	struct xml_string* content = 0;
 
 	size_t original_length;
-	struct xml_attribute** attributes;
+	struct xml_attribute** attributes = 0;
 
-	struct xml_node** children = calloc(1, sizeof(struct xml_node*));
+	size_t child_count = 0;
+	size_t child_capacity = 4;
+	struct xml_node** children = calloc(child_capacity, sizeof(struct xml_node*));
 	children[0] = 0;
 
 
@@ -751,16 +756,17 @@ static struct xml_node* xml_parse_node(struct xml_parser* parser) {
 			goto exit_failure;
 		}
 
-		/* Grow child array :)
+		/* Grow child array geometrically (nkgen: was one recount and realloc per child)
 		 */
-		size_t old_elements = get_zero_terminated_array_nodes(children);
-		size_t new_elements = old_elements + 1;
-		children = realloc(children, (new_elements + 1) * sizeof(struct xml_node*));
+		if (child_count + 2 > child_capacity) {
+			child_capacity *= 2;
+			children = realloc(children, child_capacity * sizeof(struct xml_node*));
+		}
 
 		/* Save child
 		 */
-		children[new_elements - 1] = child;
-		children[new_elements] = 0;
+		children[child_count++] = child;
+		children[child_count] = 0;
 	}
 
 
@@ -791,6 +797,8 @@ node_creation:;
 	node->content = content;
 	node->attributes = attributes;
 	node->children = children;
+	node->attribute_count = get_zero_terminated_array_attributes(attributes);
+	node->child_count = child_count;
 	return node;
 
 
@@ -807,6 +815,17 @@ exit_failure:
 		xml_string_free(content);
 	}
 
+	/* nkgen: attributes of the failed node were leaked here
+	 */
+	if (attributes) {
+		struct xml_attribute** at = attributes;
+		while (*at) {
+			xml_attribute_free(*at);
+			++at;
+		}
+		free(attributes);
+	}
+
 	struct xml_node** it = children;
 	while (*it) {
 		xml_node_free(*it);
@@ -821,6 +840,15 @@ exit_failure:
 
 
 
+/**
+ * [PUBLIC API]
+ */
+void xml_set_error_handler(xml_error_handler handler) {
+	error_handler = handler;
+}
+
+
+
 /**
  * [PUBLIC API]
  */
@@ -951,11 +979,9 @@ struct xml_string* xml_node_content(struct xml_node* node) {
 
 /**
  * [PUBLIC API]
- *
- * @warning O(n)
  */
 size_t xml_node_children(struct xml_node* node) {
-	return get_zero_terminated_array_nodes(node->children);
+	return node->child_count;
 }
 
 
@@ -977,7 +1003,7 @@ struct xml_node* xml_node_child(struct xml_node* node, size_t child) {
  * [PUBLIC API]
  */
 size_t xml_node_attributes(struct xml_node* node) {
-	return get_zero_terminated_array_attributes(node->attributes);
+	return node->attribute_count;
 }
 
 
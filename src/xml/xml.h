@@ -50,6 +50,21 @@ struct xml_string;
 
 
 
+/**
+ * nkgen: callback for parser errors, row and column are 1 based
+ */
+typedef void (*xml_error_handler)(size_t row, size_t column, char const* message);
+
+
+
+/**
+ * nkgen: routes parser errors to handler instead of stderr, 0 restores
+ * the default
+ */
+void xml_set_error_handler(xml_error_handler handler);
+
+
+
 /**
  * Tries to parse the XML fragment in buffer
  *